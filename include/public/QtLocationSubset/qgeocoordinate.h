@@ -75,6 +75,12 @@ public:
         DegreesMinutesSecondsWithHemisphere
     };
 
+    enum DistanceMode {
+        SphericalDistance,
+        EquirectangularDistance,
+        EllipsoidalDistance
+    };
+
     QGeoCoordinate();
     QGeoCoordinate(double latitude, double longitude);
     QGeoCoordinate(double latitude, double longitude, double altitude);
@@ -101,12 +107,24 @@ public:
     double altitude() const;
 
     qreal distanceTo(const QGeoCoordinate &other) const;
+    qreal distanceTo(const QGeoCoordinate &other, DistanceMode mode) const;
     qreal azimuthTo(const QGeoCoordinate &other) const;
+    qreal azimuthTo(const QGeoCoordinate &other, DistanceMode mode) const;
 
     QGeoCoordinate atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp = 0.0) const;
+    QGeoCoordinate atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp,
+                                        DistanceMode mode) const;
+
+    static void setDefaultDistanceMode(DistanceMode mode);
+    static DistanceMode defaultDistanceMode();
 
     QString toString(CoordinateFormat format = DegreesMinutesSecondsWithHemisphere) const;
 
+    QString toGeohash(int precision = 12) const;
+    static QGeoCoordinate fromGeohash(const QString &geohash);
+    QString toQuadKey(int level = 23) const;
+    static QGeoCoordinate fromQuadKey(const QString &quadKey);
+
 private:
     QGeoCoordinatePrivate *d;
 
@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QGEOCOORDINATEVALUE_H
+#define QGEOCOORDINATEVALUE_H
+
+#include "qmobilitysubset.h"
+#include "qgeocoordinate.h"
+
+#include <qnumeric.h>
+
+QT_BEGIN_HEADER
+
+QTMS_BEGIN_NAMESPACE
+
+class Q_LOCATION_EXPORT QGeoCoordinateValue
+{
+public:
+    inline QGeoCoordinateValue()
+        : m_latitude(qQNaN()), m_longitude(qQNaN()), m_altitude(qQNaN()) {}
+    inline QGeoCoordinateValue(double latitude, double longitude)
+        : m_latitude(qQNaN()), m_longitude(qQNaN()), m_altitude(qQNaN()) {
+        if (isValidLatLong(latitude, longitude)) {
+            m_latitude = latitude;
+            m_longitude = longitude;
+        }
+    }
+    inline QGeoCoordinateValue(double latitude, double longitude, double altitude)
+        : m_latitude(qQNaN()), m_longitude(qQNaN()), m_altitude(qQNaN()) {
+        if (isValidLatLong(latitude, longitude)) {
+            m_latitude = latitude;
+            m_longitude = longitude;
+            m_altitude = altitude;
+        }
+    }
+    QGeoCoordinateValue(const QGeoCoordinate &coordinate);
+
+    QGeoCoordinate toCoordinate() const;
+
+    bool operator==(const QGeoCoordinateValue &other) const;
+    inline bool operator!=(const QGeoCoordinateValue &other) const {
+        return !operator==(other);
+    }
+
+    bool isValid() const;
+    QGeoCoordinate::CoordinateType type() const;
+
+    inline void setLatitude(double latitude) {
+        m_latitude = latitude;
+    }
+    inline double latitude() const {
+        return m_latitude;
+    }
+
+    inline void setLongitude(double longitude) {
+        m_longitude = longitude;
+    }
+    inline double longitude() const {
+        return m_longitude;
+    }
+
+    inline void setAltitude(double altitude) {
+        m_altitude = altitude;
+    }
+    inline double altitude() const {
+        return m_altitude;
+    }
+
+    qreal distanceTo(const QGeoCoordinateValue &other) const;
+    qreal distanceTo(const QGeoCoordinateValue &other, QGeoCoordinate::DistanceMode mode) const;
+    qreal azimuthTo(const QGeoCoordinateValue &other) const;
+    qreal azimuthTo(const QGeoCoordinateValue &other, QGeoCoordinate::DistanceMode mode) const;
+
+    QGeoCoordinateValue atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp = 0.0) const;
+    QGeoCoordinateValue atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp,
+                                             QGeoCoordinate::DistanceMode mode) const;
+
+private:
+    inline static bool isValidLatLong(double latitude, double longitude) {
+        return latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180;
+    }
+
+    double m_latitude;
+    double m_longitude;
+    double m_altitude;
+};
+
+QTMS_END_NAMESPACE
+
+Q_DECLARE_TYPEINFO(QtMobilitySubset::QGeoCoordinateValue, Q_MOVABLE_TYPE);
+
+QT_END_HEADER
+
+#endif
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QGEOPOSITIONHUB_H
+#define QGEOPOSITIONHUB_H
+
+#include "qmobilitysubset.h"
+#include "qgeopositioninfo.h"
+
+#include <QObject>
+
+QT_BEGIN_HEADER
+
+QTMS_BEGIN_NAMESPACE
+
+class QGeoPositionInfoSource;
+class QGeoPositionHubPrivate;
+class QGeoPositionHubReaderPrivate;
+
+struct QGeoPositionFix
+{
+    qint64 timestamp;
+    double latitude;
+    double longitude;
+    double altitude;
+    double attributes[QGeoPositionInfo::VerticalAccuracy + 1];
+};
+
+class Q_LOCATION_EXPORT QGeoPositionHub : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QGeoPositionHub(int capacity = 64, QObject *parent = 0);
+    ~QGeoPositionHub();
+
+    int capacity() const;
+
+    void setSource(QGeoPositionInfoSource *source);
+    QGeoPositionInfoSource *source() const;
+
+    void publish(const QGeoPositionFix &fix);
+
+    static QGeoPositionFix toFix(const QGeoPositionInfo &info);
+    static QGeoPositionInfo toPositionInfo(const QGeoPositionFix &fix);
+
+public Q_SLOTS:
+    void publish(const QGeoPositionInfo &info);
+
+private:
+    Q_DISABLE_COPY(QGeoPositionHub)
+    friend class QGeoPositionHubReader;
+    QGeoPositionHubPrivate *d;
+};
+
+class Q_LOCATION_EXPORT QGeoPositionHubReader
+{
+public:
+    explicit QGeoPositionHubReader(QGeoPositionHub *hub, int decimation = 1);
+    ~QGeoPositionHubReader();
+
+    void setDecimation(int decimation);
+    int decimation() const;
+
+    bool read(QGeoPositionFix *fix);
+    bool readLatest(QGeoPositionFix *fix);
+
+    int lostCount() const;
+
+private:
+    Q_DISABLE_COPY(QGeoPositionHubReader)
+    QGeoPositionHubReaderPrivate *d;
+};
+
+QTMS_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif
@@ -46,6 +46,7 @@
 
 #include <QDateTime>
 #include <QMetaType>
+#include <QSharedDataPointer>
 
 QT_BEGIN_NAMESPACE
 class QDebug;
@@ -103,7 +104,7 @@ private:
     friend Q_LOCATION_EXPORT QDataStream &operator<<(QDataStream &stream, const QGeoPositionInfo &info);
     friend Q_LOCATION_EXPORT QDataStream &operator>>(QDataStream &stream, QGeoPositionInfo &info);
 #endif
-    QGeoPositionInfoPrivate *d;
+    QSharedDataPointer<QGeoPositionInfoPrivate> d;
 };
 
 #ifndef QT_NO_DEBUG_STREAM
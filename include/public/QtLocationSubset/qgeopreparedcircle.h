@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QGEOPREPAREDCIRCLE_H
+#define QGEOPREPAREDCIRCLE_H
+
+#include "qmobilitysubset.h"
+#include "qgeocoordinatevalue.h"
+
+QT_BEGIN_HEADER
+
+QTMS_BEGIN_NAMESPACE
+
+class QGeoBoundingCircle;
+
+class Q_LOCATION_EXPORT QGeoPreparedCircle
+{
+public:
+    QGeoPreparedCircle();
+    QGeoPreparedCircle(const QGeoCoordinateValue &center, qreal radius);
+    explicit QGeoPreparedCircle(const QGeoBoundingCircle &circle);
+
+    bool isValid() const;
+
+    inline QGeoCoordinateValue center() const {
+        return m_center;
+    }
+    inline qreal radius() const {
+        return m_radius;
+    }
+
+    qreal distanceTo(const QGeoCoordinateValue &coordinate) const;
+    bool contains(const QGeoCoordinateValue &coordinate) const;
+
+private:
+    void prepare();
+    double haversine(const QGeoCoordinateValue &coordinate) const;
+
+    QGeoCoordinateValue m_center;
+    qreal m_radius;
+    double m_latitudeRad;
+    double m_longitudeRad;
+    double m_cosLatitude;
+    double m_maxHaversine;
+};
+
+QTMS_END_NAMESPACE
+
+Q_DECLARE_TYPEINFO(QtMobilitySubset::QGeoPreparedCircle, Q_MOVABLE_TYPE);
+
+QT_END_HEADER
+
+#endif
@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOSEARCHBATCHREPLY_H
+#define QGEOSEARCHBATCHREPLY_H
+
+#include "qgeosearchreply.h"
+#include "qgeoplace.h"
+
+#include <QObject>
+#include <QList>
+
+QTMS_BEGIN_NAMESPACE
+
+class QGeoSearchBatchReplyPrivate;
+
+class Q_LOCATION_EXPORT QGeoSearchBatchReply : public QObject
+{
+    Q_OBJECT
+
+public:
+    QGeoSearchBatchReply(QGeoSearchReply::Error error, const QString &errorString, QObject *parent = 0);
+    virtual ~QGeoSearchBatchReply();
+
+    bool isFinished() const;
+    QGeoSearchReply::Error error() const;
+    QString errorString() const;
+
+    int count() const;
+    int finishedCount() const;
+
+    QList<QGeoPlace> places(int index) const;
+    QGeoSearchReply::Error resultError(int index) const;
+
+    virtual void abort();
+
+Q_SIGNALS:
+    void resultsReady(int first, int last);
+    void progress(int finished, int total);
+    void finished();
+    void error(QGeoSearchReply::Error error, const QString &errorString = QString());
+
+protected:
+    QGeoSearchBatchReply(int count, QObject *parent = 0);
+
+    void setError(QGeoSearchReply::Error error, const QString &errorString);
+    void setFinished(bool finished);
+
+    void setResult(int index, const QList<QGeoPlace> &places,
+                   QGeoSearchReply::Error error = QGeoSearchReply::NoError);
+    void setResultsReady(int first, int last);
+
+private:
+    QGeoSearchBatchReplyPrivate *d_ptr;
+    Q_DISABLE_COPY(QGeoSearchBatchReply)
+};
+
+QTMS_END_NAMESPACE
+
+#endif
@@ -43,6 +43,7 @@
 #define QGEOSEARCHMANAGER_H
 
 #include "qgeosearchreply.h"
+#include "qgeosearchbatchreply.h"
 #include "qgeoboundingbox.h"
 
 #include <QObject>
@@ -77,6 +78,11 @@ public:
     QGeoSearchReply* reverseGeocode(const QGeoCoordinate &coordinate,
                                     QGeoBoundingArea *bounds = 0);
 
+    QGeoSearchBatchReply* geocodeBatch(const QList<QGeoAddress> &addresses,
+                                       QGeoBoundingArea *bounds = 0);
+    QGeoSearchBatchReply* reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates,
+                                              QGeoBoundingArea *bounds = 0);
+
     QGeoSearchReply* search(const QString &searchString,
                             SearchTypes searchTypes = SearchTypes(SearchAll),
                             int limit = -1,
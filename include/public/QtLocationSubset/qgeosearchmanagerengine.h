@@ -44,6 +44,7 @@
 
 #include "qgeosearchmanager.h"
 #include "qgeosearchreply.h"
+#include "qgeosearchbatchreply.h"
 #include "qgeoboundingbox.h"
 
 #include <QObject>
@@ -68,6 +69,11 @@ public:
     virtual QGeoSearchReply* reverseGeocode(const QGeoCoordinate &coordinate,
                                             QGeoBoundingArea *bounds);
 
+    virtual QGeoSearchBatchReply* geocodeBatch(const QList<QGeoAddress> &addresses,
+                                               QGeoBoundingArea *bounds);
+    virtual QGeoSearchBatchReply* reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates,
+                                                      QGeoBoundingArea *bounds);
+
     virtual QGeoSearchReply* search(const QString &searchString,
                                     QGeoSearchManager::SearchTypes searchTypes,
                                     int limit,
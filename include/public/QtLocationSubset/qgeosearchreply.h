@@ -84,6 +84,7 @@ public:
 Q_SIGNALS:
     void finished();
     void error(QGeoSearchReply::Error error, const QString &errorString = QString());
+    void placesAdded(int first, int last);
 
 protected:
     QGeoSearchReply(QObject* parent = 0);
@@ -93,6 +94,7 @@ protected:
 
     void setViewport(QGeoBoundingArea *viewport);
     void addPlace(const QGeoPlace &place);
+    void addPlaces(const QList<QGeoPlace> &places);
     void setPlaces(const QList<QGeoPlace> &places);
 
     void setLimit(int limit);
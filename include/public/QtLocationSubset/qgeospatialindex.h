@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QGEOSPATIALINDEX_H
+#define QGEOSPATIALINDEX_H
+
+#include "qmobilitysubset.h"
+#include "qgeocoordinate.h"
+
+#include <QList>
+#include <QSharedDataPointer>
+
+QT_BEGIN_HEADER
+
+QTMS_BEGIN_NAMESPACE
+
+class QGeoBoundingArea;
+class QGeoBoundingBox;
+class QGeoBoundingCircle;
+class QGeoPlace;
+class QGeoSpatialIndexPrivate;
+
+class Q_LOCATION_EXPORT QGeoSpatialIndex
+{
+public:
+    QGeoSpatialIndex();
+    explicit QGeoSpatialIndex(const QList<QGeoCoordinate> &coordinates);
+    explicit QGeoSpatialIndex(const QList<QGeoPlace> &places);
+    QGeoSpatialIndex(const QGeoSpatialIndex &other);
+    ~QGeoSpatialIndex();
+
+    QGeoSpatialIndex &operator=(const QGeoSpatialIndex &other);
+
+    int count() const;
+    QGeoCoordinate coordinate(int index) const;
+
+    QList<int> indexesWithin(const QGeoBoundingBox &box) const;
+    QList<int> indexesWithin(const QGeoBoundingCircle &circle) const;
+    QList<int> indexesWithin(const QGeoBoundingArea &area) const;
+
+    QList<int> nearest(const QGeoCoordinate &coordinate, int count) const;
+
+private:
+    QSharedDataPointer<QGeoSpatialIndexPrivate> d_ptr;
+};
+
+QTMS_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif
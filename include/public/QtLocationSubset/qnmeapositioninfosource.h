@@ -57,6 +57,7 @@ class QNmeaPositionInfoSourcePrivate;
 class Q_LOCATION_EXPORT QNmeaPositionInfoSource : public QGeoPositionInfoSource
 {
     Q_OBJECT
+    Q_PROPERTY(qreal playbackRate READ playbackRate WRITE setPlaybackRate)
 public:
     enum UpdateMode {
         RealTimeMode = 1,
@@ -73,10 +74,16 @@ public:
 
     void setUpdateInterval(int msec);
 
+    void setPlaybackRate(qreal rate);
+    qreal playbackRate() const;
+    bool seek(const QDateTime &dateTime);
+
     QGeoPositionInfo lastKnownPosition(bool fromSatellitePositioningMethodsOnly = false) const;
     PositioningMethods supportedPositioningMethods() const;
     int minimumUpdateInterval() const;
 
+    static bool hasValidNmeaChecksum(const char *data, int size);
+
 public Q_SLOTS:
     void startUpdates();
     void stopUpdates();
@@ -91,6 +98,7 @@ protected:
 private:
     Q_DISABLE_COPY(QNmeaPositionInfoSource)
     friend class QNmeaPositionInfoSourcePrivate;
+    friend class QNmeaSatelliteInfoSourcePrivate;
     QNmeaPositionInfoSourcePrivate *d;
 };
 
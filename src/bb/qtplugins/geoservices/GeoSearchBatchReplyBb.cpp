@@ -0,0 +1,168 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#include "GeoSearchBatchReplyBb.hpp"
+#include "GeoSearchReplyBb.hpp"
+
+#include <QList>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+GeoSearchBatchReplyBb::GeoSearchBatchReplyBb( int count, const QtMobilitySubset::QGeoBoundingArea * bounds, QObject * parent )
+    : QGeoSearchBatchReply( count, parent ),
+      _bounds( NULL )
+{
+    setBounds( bounds );
+    connect( &_futureWatcher, SIGNAL(resultsReadyAt(int, int)), SLOT(receiveResults(int, int)) );
+}
+
+GeoSearchBatchReplyBb::~GeoSearchBatchReplyBb()
+{
+    // nobody is interested in the results any more.
+    cancelRequests();
+}
+
+void GeoSearchBatchReplyBb::setCachedPlaces( int index, const QList<QtMobilitySubset::QGeoPlace> & places )
+{
+    setResult( index, GeoSearchReplyBb::placesWithin( places, _bounds ) );
+    _cachedIndices.append( index );
+}
+
+void GeoSearchBatchReplyBb::addRequest( int index, const GeoregRequest & request, const QString & cacheKey )
+{
+    _requests.append( request );
+    _requestIndices.append( index );
+    _cacheKeys.append( cacheKey );
+}
+
+void GeoSearchBatchReplyBb::start( const QSharedPointer<GeoSearchWorkerPoolBb> & workerPool,
+                                   const QSharedPointer<GeoSearchCacheBb> & cache, int chunkSize )
+{
+    if ( !_requests.isEmpty() ) {
+        _workerPool = workerPool;
+        _cache = cache;
+        _future = workerPool->submitBatch( _requests, chunkSize, GeoSearchWorkerPoolBb::BackgroundPriority );
+        _futureWatcher.setFuture( _future );
+        _requests.clear();
+    }
+
+    // announce the cached results on the next turn of the event loop, as results from the georeg service would be,
+    // so that the caller has the chance to connect to the signals first. This also finishes an empty batch.
+    QMetaObject::invokeMethod( this, "receiveCachedResults", Qt::QueuedConnection );
+}
+
+// Cancels the requests that have not been answered yet. The results that were announced are kept.
+void GeoSearchBatchReplyBb::abort()
+{
+    if ( isFinished() ) {
+        return;
+    }
+
+    cancelRequests();
+    QGeoSearchBatchReply::abort();
+}
+
+// Withdraw the batch from the worker pool, which takes its queued chunks out of the queue, and stop watching it.
+void GeoSearchBatchReplyBb::cancelRequests()
+{
+    if ( !_workerPool ) {
+        return;
+    }
+
+    _futureWatcher.disconnect( this );
+    _workerPool->cancel( _future );
+    _workerPool.clear();
+    _cache.clear();
+}
+
+// SLOT
+void GeoSearchBatchReplyBb::receiveResults( int begin, int end )
+{
+    QList<int> indices;
+    for ( int i = begin ; i < end ; i++ ) {
+        GeoregReply georegReply = _future.resultAt( i );
+        int index = _requestIndices.at( i );
+
+        // cache the unbounded places, so that they can answer later requests with other bounds.
+        if ( _cache && georegReply.error == QtMobilitySubset::QGeoSearchReply::NoError && !_cacheKeys.at( i ).isEmpty() ) {
+            _cache->insert( _cacheKeys.at( i ), georegReply.places );
+        }
+
+        setResult( index, GeoSearchReplyBb::placesWithin( georegReply.places, _bounds ), georegReply.error );
+        indices.append( index );
+    }
+
+    announceResults( indices );
+
+    // Since QGeoSearchBatchReply and its descendents are left to the user to destroy, release unnecessary resources
+    // once the batch is done.
+    if ( isFinished() ) {
+        _workerPool.clear();
+        _cache.clear();
+    }
+}
+
+// SLOT
+void GeoSearchBatchReplyBb::receiveCachedResults()
+{
+    if ( isFinished() ) {
+        return;
+    }
+
+    // a batch without addresses or coordinates has nothing to announce.
+    if ( count() == 0 ) {
+        setFinished( true );
+        return;
+    }
+
+    announceResults( _cachedIndices );
+    _cachedIndices.clear();
+}
+
+// Announce the results at indices, which are in ascending order, in ranges of consecutive indices.
+void GeoSearchBatchReplyBb::announceResults( const QList<int> & indices )
+{
+    int first = 0;
+    for ( int i = 1 ; i <= indices.size() ; i++ ) {
+        if ( i == indices.size() || indices.at(i) != indices.at(i - 1) + 1 ) {
+            setResultsReady( indices.at(first), indices.at(i - 1) );
+            first = i;
+        }
+    }
+}
+
+// Make a copy of the bounds, which are applied to the results as they are received.
+void GeoSearchBatchReplyBb::setBounds( const QtMobilitySubset::QGeoBoundingArea * bounds )
+{
+    if ( bounds )
+    {
+        switch ( bounds->type() )
+        {
+        case QtMobilitySubset::QGeoBoundingArea::BoxType:
+            _boundingBox = *( static_cast<const QtMobilitySubset::QGeoBoundingBox*>(bounds) );
+            _bounds = &_boundingBox;
+            break;
+
+        case QtMobilitySubset::QGeoBoundingArea::CircleType:
+            _boundingCircle = *( static_cast<const QtMobilitySubset::QGeoBoundingCircle*>(bounds) );
+            _bounds = &_boundingCircle;
+            break;
+
+        default:
+            _bounds = NULL;
+            break;
+        }
+    }
+}
+
+} // namespace
+} // namespace
+} // namespace
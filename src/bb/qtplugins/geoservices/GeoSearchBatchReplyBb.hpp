@@ -0,0 +1,106 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHBATCHREPLYBB_HPP
+#define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHBATCHREPLYBB_HPP
+
+#include "GeoSearchCacheBb.hpp"
+#include "GeoSearchWorkerPoolBb.hpp"
+
+#include <QGeoSearchBatchReply>
+#include <QGeoBoundingArea>
+#include <QGeoBoundingBox>
+#include <QGeoBoundingCircle>
+#include <QGeoPlace>
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+/**
+ * The reply to a batch of geocode or reverse geocode requests.
+ *
+ * The engine sets the result of each address or coordinate that it finds in its cache and adds a georeg request
+ * for each of the others, then starts the batch. The requests are sent in chunks by the worker pool, and the
+ * results of each chunk are announced as the worker pool reports them.
+ */
+class GeoSearchBatchReplyBb : public QtMobilitySubset::QGeoSearchBatchReply
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param count The number of addresses or coordinates in the batch.
+     * @param bounds The bounds the places of every result are limited to, if not null.
+     */
+    GeoSearchBatchReplyBb( int count, const QtMobilitySubset::QGeoBoundingArea * bounds, QObject * parent = 0 );
+    virtual ~GeoSearchBatchReplyBb();
+
+    // sets the result of index to places found in a cache, before start()
+    void setCachedPlaces( int index, const QList<QtMobilitySubset::QGeoPlace> & places );
+
+    /**
+     * Adds the request for index, before start().
+     *
+     * @param cacheKey The key the places received for the request are stored under in the cache, or an empty
+     * string if they are not cached.
+     */
+    void addRequest( int index, const GeoregRequest & request, const QString & cacheKey );
+
+    /**
+     * Queues the requests on workerPool, in chunks of chunkSize, behind the interactive requests.
+     *
+     * @param cache The cache the places received are stored in, if not null.
+     */
+    void start( const QSharedPointer<GeoSearchWorkerPoolBb> & workerPool, const QSharedPointer<GeoSearchCacheBb> & cache,
+                int chunkSize );
+
+    virtual void abort();
+
+public Q_SLOTS:
+    void receiveResults( int begin, int end );
+    void receiveCachedResults();
+
+private:
+    Q_DISABLE_COPY(GeoSearchBatchReplyBb)
+
+    void setBounds( const QtMobilitySubset::QGeoBoundingArea * bounds );
+    void announceResults( const QList<int> & indices );
+    void cancelRequests();
+
+    QFuture<GeoregReply> _future;
+    QFutureWatcher<GeoregReply> _futureWatcher;
+    QSharedPointer<GeoSearchWorkerPoolBb> _workerPool;
+    QSharedPointer<GeoSearchCacheBb> _cache;
+
+    // the requests, and for each the index in the batch and the cache key, in the order of the results
+    QList<GeoregRequest> _requests;
+    QList<int> _requestIndices;
+    QList<QString> _cacheKeys;
+
+    // the indices of the results found in a cache, which are announced once the batch has started
+    QList<int> _cachedIndices;
+
+    QtMobilitySubset::QGeoBoundingArea * _bounds;
+    QtMobilitySubset::QGeoBoundingBox _boundingBox;
+    QtMobilitySubset::QGeoBoundingCircle _boundingCircle;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
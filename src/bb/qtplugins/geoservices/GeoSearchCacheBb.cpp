@@ -0,0 +1,124 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#include "GeoSearchCacheBb.hpp"
+
+#include <QDateTime>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+GeoSearchCacheBb::GeoSearchCacheBb( int capacity, int timeToLive )
+    : _entries( qMax( capacity, 0 ) ),
+      _timeToLive( qMax( timeToLive, 0 ) ),
+      _hits( 0 ),
+      _misses( 0 )
+{
+    _clock.start();
+}
+
+bool GeoSearchCacheBb::isEnabled() const
+{
+    return _entries.maxCost() > 0;
+}
+
+int GeoSearchCacheBb::capacity() const
+{
+    return _entries.maxCost();
+}
+
+int GeoSearchCacheBb::timeToLive() const
+{
+    return _timeToLive;
+}
+
+int GeoSearchCacheBb::size() const
+{
+    return _entries.size();
+}
+
+bool GeoSearchCacheBb::find( const QString & key, QList<QtMobilitySubset::QGeoPlace> * places )
+{
+    // QCache::object() also makes the entry the most recently used one.
+    Entry * entry = _entries.object( key );
+    if ( entry && _timeToLive > 0 && _clock.elapsed() >= entry->expiry ) {
+        _entries.remove( key );
+        entry = NULL;
+    }
+
+    if ( !entry && _store ) {
+        // the store keeps the time the entry expires since the epoch, as it outlives this cache's clock.
+        qint64 expiry;
+        if ( _store->find( _storePrefix + key.toUtf8(), places, &expiry ) ) {
+            qint64 timeLeft = expiry == 0 ? qint64( _timeToLive ) * 1000 : expiry - QDateTime::currentMSecsSinceEpoch();
+            insertEntry( key, *places, _clock.elapsed() + timeLeft );
+            _hits++;
+            return true;
+        }
+    }
+
+    if ( !entry ) {
+        _misses++;
+        return false;
+    }
+
+    _hits++;
+    *places = entry->places;
+    return true;
+}
+
+void GeoSearchCacheBb::insert( const QString & key, const QList<QtMobilitySubset::QGeoPlace> & places )
+{
+    if ( !isEnabled() ) {
+        return;
+    }
+
+    insertEntry( key, places, _clock.elapsed() + qint64( _timeToLive ) * 1000 );
+
+    if ( _store ) {
+        qint64 expiry = _timeToLive > 0 ? QDateTime::currentMSecsSinceEpoch() + qint64( _timeToLive ) * 1000 : 0;
+        _store->insert( _storePrefix + key.toUtf8(), places, expiry );
+    }
+}
+
+void GeoSearchCacheBb::clear()
+{
+    _entries.clear();
+}
+
+void GeoSearchCacheBb::setStore( const QSharedPointer<GeoSearchStoreBb> & store, const QByteArray & prefix )
+{
+    _store = store;
+    _storePrefix = prefix;
+}
+
+void GeoSearchCacheBb::insertEntry( const QString & key, const QList<QtMobilitySubset::QGeoPlace> & places, qint64 expiry )
+{
+    Entry * entry = new Entry;
+    entry->places = places;
+    entry->expiry = expiry;
+
+    // QCache takes ownership of the entry and evicts the least recently used entries to make room for it.
+    _entries.insert( key, entry );
+}
+
+quint64 GeoSearchCacheBb::hits() const
+{
+    return _hits;
+}
+
+quint64 GeoSearchCacheBb::misses() const
+{
+    return _misses;
+}
+
+} // namespace
+} // namespace
+} // namespace
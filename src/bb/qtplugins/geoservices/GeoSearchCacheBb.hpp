@@ -0,0 +1,106 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHCACHEBB_HPP
+#define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHCACHEBB_HPP
+
+#include "GeoSearchStoreBb.hpp"
+
+#include <QGeoPlace>
+
+#include <QByteArray>
+#include <QCache>
+#include <QElapsedTimer>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+/**
+ * A least-recently-used cache of georeg results, whose entries also expire a fixed time after they were
+ * inserted. The places are stored as the georeg service returned them, before any bounds were applied, so
+ * that one entry can answer requests with different bounds.
+ *
+ * The cache can be backed by a GeoSearchStoreBb, which keeps the entries across restarts: entries that are
+ * inserted are also written to the store, and keys that are not in memory are looked up in it.
+ *
+ * The cache is not thread safe; it is only used from the thread of the engine that owns it.
+ */
+class GeoSearchCacheBb
+{
+public:
+    /**
+     * Creates a cache.
+     *
+     * @param capacity The maximum number of entries. A capacity of 0 disables the cache.
+     * @param timeToLive The number of seconds an entry is used for. Entries do not expire if this is 0.
+     */
+    GeoSearchCacheBb( int capacity, int timeToLive );
+
+    bool isEnabled() const;
+    int capacity() const;
+    int timeToLive() const;
+    int size() const;
+
+    /**
+     * Looks up the places stored for a key, counting a hit or a miss.
+     *
+     * @param key The key of the request.
+     * @param places Set to the stored places if there is an entry for the key that has not expired.
+     *
+     * @return true on a hit.
+     */
+    bool find( const QString & key, QList<QtMobilitySubset::QGeoPlace> * places );
+
+    /**
+     * Stores places for a key, replacing any entry it already has and evicting the least recently used
+     * entry if the cache is full.
+     */
+    void insert( const QString & key, const QList<QtMobilitySubset::QGeoPlace> & places );
+
+    void clear();
+
+    /**
+     * Backs the cache with a store, which may be shared with other caches.
+     *
+     * @param prefix Prepended to the keys of this cache in the store, to keep them apart from those of other caches.
+     */
+    void setStore( const QSharedPointer<GeoSearchStoreBb> & store, const QByteArray & prefix );
+
+    quint64 hits() const;
+    quint64 misses() const;
+
+private:
+    Q_DISABLE_COPY(GeoSearchCacheBb)
+
+    struct Entry
+    {
+        QList<QtMobilitySubset::QGeoPlace> places;
+        qint64 expiry;
+    };
+
+    void insertEntry( const QString & key, const QList<QtMobilitySubset::QGeoPlace> & places, qint64 expiry );
+
+    QCache<QString, Entry> _entries;
+    QElapsedTimer _clock;
+    int _timeToLive;
+    QSharedPointer<GeoSearchStoreBb> _store;
+    QByteArray _storePrefix;
+    quint64 _hits;
+    quint64 _misses;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#include "GeoSearchHandlePoolBb.hpp"
+
+#include <QMutexLocker>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+GeoSearchHandlePoolBb::GeoSearchHandlePoolBb( int size, int idleTimeout )
+    : _size( qMax( size, 1 ) ),
+      _idleTimeout( qMax( idleTimeout, 0 ) ),
+      _openHandles( 0 ),
+      _acquisitions( 0 ),
+      _totalAcquisitionTime( 0 ),
+      _maximumAcquisitionTime( 0 )
+{
+    _clock.start();
+}
+
+GeoSearchHandlePoolBb::~GeoSearchHandlePoolBb()
+{
+    bbmock::GeoregApi & georegApi = bbmock::GeoregApi::getInstance();
+    for ( int i = 0 ; i < _idleHandles.size() ; i++ ) {
+        georegApi.geo_search_close( &_idleHandles[i].handle );
+    }
+}
+
+geo_search_error_t GeoSearchHandlePoolBb::acquire( geo_search_handle_t * handle, bool * reused )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QMutexLocker locker( &_mutex );
+
+    while ( _idleHandles.isEmpty() && _openHandles >= _size ) {
+        _released.wait( &_mutex );
+    }
+
+    geo_search_error_t err = GEO_SEARCH_OK;
+    if ( !_idleHandles.isEmpty() ) {
+        // take the most recently used handle, so that the others become idle and are closed.
+        *handle = _idleHandles.takeLast().handle;
+        *reused = true;
+    } else {
+        // reserve the handle while it is being opened, which may take a while, without holding the lock.
+        _openHandles++;
+        locker.unlock();
+        err = bbmock::GeoregApi::getInstance().geo_search_open( handle );
+        locker.relock();
+
+        if ( err != GEO_SEARCH_OK ) {
+            _openHandles--;
+            _released.wakeOne();
+        }
+        *reused = false;
+    }
+
+    qint64 elapsed = timer.nsecsElapsed();
+    _acquisitions++;
+    _totalAcquisitionTime += elapsed;
+    _maximumAcquisitionTime = qMax( _maximumAcquisitionTime, elapsed );
+
+    return err;
+}
+
+void GeoSearchHandlePoolBb::release( geo_search_handle_t handle, bool broken )
+{
+    if ( broken ) {
+        bbmock::GeoregApi::getInstance().geo_search_close( &handle );
+
+        QMutexLocker locker( &_mutex );
+        _openHandles--;
+        _released.wakeOne();
+        return;
+    }
+
+    QMutexLocker locker( &_mutex );
+    IdleHandle idleHandle;
+    idleHandle.handle = handle;
+    idleHandle.releasedAt = _clock.elapsed();
+    _idleHandles.append( idleHandle );
+    _released.wakeOne();
+}
+
+void GeoSearchHandlePoolBb::closeIdleHandles()
+{
+    QList<IdleHandle> expired;
+    {
+        QMutexLocker locker( &_mutex );
+        // the handles are in the order they were released, so the ones that have been idle longest come first.
+        qint64 cutoff = _clock.elapsed() - qint64( _idleTimeout ) * 1000;
+        while ( !_idleHandles.isEmpty() && _idleHandles.first().releasedAt <= cutoff ) {
+            expired.append( _idleHandles.takeFirst() );
+        }
+        _openHandles -= expired.size();
+        if ( !expired.isEmpty() ) {
+            _released.wakeAll();
+        }
+    }
+
+    bbmock::GeoregApi & georegApi = bbmock::GeoregApi::getInstance();
+    for ( int i = 0 ; i < expired.size() ; i++ ) {
+        georegApi.geo_search_close( &expired[i].handle );
+    }
+}
+
+int GeoSearchHandlePoolBb::size() const
+{
+    return _size;
+}
+
+int GeoSearchHandlePoolBb::idleTimeout() const
+{
+    return _idleTimeout;
+}
+
+double GeoSearchHandlePoolBb::averageAcquisitionTime() const
+{
+    QMutexLocker locker( &_mutex );
+    return _acquisitions ? _totalAcquisitionTime / 1000000.0 / _acquisitions : 0.0;
+}
+
+double GeoSearchHandlePoolBb::maximumAcquisitionTime() const
+{
+    QMutexLocker locker( &_mutex );
+    return _maximumAcquisitionTime / 1000000.0;
+}
+
+bool GeoSearchHandlePoolBb::isHandleError( geo_search_error_t error )
+{
+    return error == GEO_SEARCH_ERROR_SERVER_OPEN || error == GEO_SEARCH_ERROR_SERVER_RESPONSE;
+}
+
+} // namespace
+} // namespace
+} // namespace
@@ -0,0 +1,111 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHHANDLEPOOLBB_HPP
+#define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHHANDLEPOOLBB_HPP
+
+#include "private/bbmock/GeoregApi.hpp"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+/**
+ * A bounded pool of open georeg handles, shared by the worker threads of an engine, so that requests reuse the
+ * server connection of a handle instead of opening and closing one each.
+ *
+ * A handle that fails with a server error is closed rather than returned to the pool, and handles that have
+ * not been used for the idle timeout are closed by closeIdleHandles(), which the engine calls on a timer.
+ *
+ * The pool is thread safe.
+ */
+class GeoSearchHandlePoolBb
+{
+public:
+    /**
+     * Creates an empty pool. Handles are opened when they are first needed.
+     *
+     * @param size The maximum number of handles open at the same time.
+     * @param idleTimeout The number of seconds an unused handle is kept open for.
+     */
+    GeoSearchHandlePoolBb( int size, int idleTimeout );
+
+    /**
+     * Closes the idle handles. Handles that are still in use are closed when they are released.
+     */
+    ~GeoSearchHandlePoolBb();
+
+    /**
+     * Takes a handle from the pool, opening one if none is idle, and waiting for one to be released if the
+     * pool is at its maximum size.
+     *
+     * @param handle Set to the handle.
+     * @param reused Set to true if the handle was used before, so may have lost its connection to the server.
+     *
+     * @return The error from opening a handle, in which case none was taken.
+     */
+    geo_search_error_t acquire( geo_search_handle_t * handle, bool * reused );
+
+    /**
+     * Returns a handle to the pool.
+     *
+     * @param broken Whether the handle failed with a server error, in which case it is closed.
+     */
+    void release( geo_search_handle_t handle, bool broken );
+
+    /**
+     * Closes the handles that have been idle for longer than the idle timeout.
+     */
+    void closeIdleHandles();
+
+    int size() const;
+    int idleTimeout() const;
+
+    // the average and the longest time acquire() took, in milliseconds
+    double averageAcquisitionTime() const;
+    double maximumAcquisitionTime() const;
+
+    /**
+     * Returns whether a request that failed with error may have failed because of its handle, rather than
+     * because of the request.
+     */
+    static bool isHandleError( geo_search_error_t error );
+
+private:
+    Q_DISABLE_COPY(GeoSearchHandlePoolBb)
+
+    struct IdleHandle
+    {
+        geo_search_handle_t handle;
+        qint64 releasedAt;
+    };
+
+    mutable QMutex _mutex;
+    QWaitCondition _released;
+    QElapsedTimer _clock;
+    QList<IdleHandle> _idleHandles;
+    int _size;
+    int _idleTimeout;
+    int _openHandles;
+
+    quint64 _acquisitions;
+    qint64 _totalAcquisitionTime;
+    qint64 _maximumAcquisitionTime;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -6,6 +6,7 @@
 
 
 #include "GeoSearchManagerEngineBb.hpp"
+#include "GeoSearchBatchReplyBb.hpp"
 #include "GeoSearchReplyBb.hpp"
 
 #include <QObject>
@@ -14,6 +15,7 @@
 #include <QtDebug>
 
 #include <QGeoAddress>
+#include <QGeoCellKey>
 #include <QGeoCoordinate>
 
 namespace
@@ -37,6 +39,35 @@ namespace
     // maps strings that specify a boundary in the georeg interface to the corresponding geo_search boundary enum
     const QMap<QString, geo_search_boundary_t> stringToBoundaryMap = createStringToBoundaryMap();
 
+    const int DefaultWorkerPoolSize = 4;
+    const int DefaultPlacesChunkSize = 10;
+    const int DefaultBatchChunkSize = 25;
+
+    const int DefaultHandlePoolSize = 4;
+    const int DefaultHandlePoolIdleTimeout = 60;
+
+    const int DefaultStoreMaxSize = 4 * 1024 * 1024;
+    const int StoreCompactionInterval = 30 * 1000;
+
+    const int DefaultGeocodeCacheSize = 500;
+    const int DefaultGeocodeCacheTimeToLive = 3600;
+    const int DefaultGeocodeCacheHintPrecision = 5;
+
+    const int DefaultReverseGeocodeCacheSize = 100;
+    const int DefaultReverseGeocodeCacheTimeToLive = 300;
+    const int DefaultReverseGeocodeCachePrecision = 9;
+
+    // returns the non-negative integer provider parameter called name, or defaultValue if it is not set or not valid.
+    int intParameter( const QMap<QString, QVariant> & parameters, const QString & name, int defaultValue )
+    {
+        bool ok = false;
+        int value = parameters.value( name ).toInt( &ok );
+        if ( !ok || value < 0 ) {
+            return defaultValue;
+        }
+        return value;
+    }
+
 } // namespace
 
 namespace bb
@@ -51,8 +82,37 @@ namespace geoservices
     to pass any implementation specific data to the engine.
 */
 GeoSearchManagerEngineBb::GeoSearchManagerEngineBb(const QMap<QString, QVariant> &parameters, QObject *parent)
-    : QGeoSearchManagerEngine(parameters,parent)
+    : QGeoSearchManagerEngine(parameters,parent),
+      _handlePool( new GeoSearchHandlePoolBb( intParameter( parameters, "handlepool.size", DefaultHandlePoolSize ),
+                                              intParameter( parameters, "handlepool.idletimeout", DefaultHandlePoolIdleTimeout ) ) ),
+      _workerPool( new GeoSearchWorkerPoolBb( intParameter( parameters, "workerpool.size", DefaultWorkerPoolSize ),
+                                              intParameter( parameters, "places.chunksize", DefaultPlacesChunkSize ),
+                                              _handlePool ) ),
+      _batchChunkSize( intParameter( parameters, "batch.chunksize", DefaultBatchChunkSize ) ),
+      _geocodeCache( new GeoSearchCacheBb( intParameter( parameters, "geocode.cache.size", DefaultGeocodeCacheSize ),
+                                           intParameter( parameters, "geocode.cache.ttl", DefaultGeocodeCacheTimeToLive ) ) ),
+      _geocodeCacheHintPrecision( intParameter( parameters, "geocode.cache.hintprecision", DefaultGeocodeCacheHintPrecision ) ),
+      _reverseGeocodeCache( new GeoSearchCacheBb( intParameter( parameters, "reversegeocode.cache.size", DefaultReverseGeocodeCacheSize ),
+                                                  intParameter( parameters, "reversegeocode.cache.ttl", DefaultReverseGeocodeCacheTimeToLive ) ) ),
+      _reverseGeocodeCachePrecision( intParameter( parameters, "reversegeocode.cache.precision", DefaultReverseGeocodeCachePrecision ) )
 {
+    // check for idle handles twice per timeout, so that none is kept open for much longer than the timeout.
+    connect( &_idleHandleTimer, SIGNAL(timeout()), SLOT(closeIdleHandles()) );
+    _idleHandleTimer.start( qMax( _handlePool->idleTimeout() * 500, 1000 ) );
+
+    QString storePath = parameters.value( "cache.store.path" ).toString();
+    if ( !storePath.isEmpty() ) {
+        _store = QSharedPointer<GeoSearchStoreBb>( new GeoSearchStoreBb( storePath, intParameter( parameters, "cache.store.maxsize", DefaultStoreMaxSize ) ) );
+        if ( _store->isOpen() ) {
+            _geocodeCache->setStore( _store, "g|" );
+            _reverseGeocodeCache->setStore( _store, "r|" );
+
+            // compacting rewrites the log, so it is kept off the path of the inserts and done now and then.
+            connect( &_storeCompactionTimer, SIGNAL(timeout()), SLOT(compactStore()) );
+            _storeCompactionTimer.start( StoreCompactionInterval );
+        }
+    }
+
     setSupportedSearchTypes(QtMobilitySubset::QGeoSearchManager::SearchNone);
     setSupportsGeocoding( true );
     setSupportsReverseGeocoding( true );
@@ -99,7 +159,21 @@ GeoSearchManagerEngineBb::~GeoSearchManagerEngineBb()
 QtMobilitySubset::QGeoSearchReply* GeoSearchManagerEngineBb::geocode(const QtMobilitySubset::QGeoAddress &address,
         QtMobilitySubset::QGeoBoundingArea *bounds)
 {
-    QtMobilitySubset::QGeoSearchReply * reply = new GeoSearchReplyBb( address, bounds, this);
+    // Answer repeated requests for the same address from the cache.
+    QString cacheKey = geocodeCacheKey( address, bounds );
+    if ( !cacheKey.isEmpty() ) {
+        QList<QtMobilitySubset::QGeoPlace> cachedPlaces;
+        if ( _geocodeCache->find( cacheKey, &cachedPlaces ) ) {
+            QtMobilitySubset::QGeoSearchReply * reply = new GeoSearchReplyBb( cachedPlaces, bounds, this );
+            connectReplySignals( *reply );
+            return reply;
+        }
+    }
+
+    GeoSearchReplyBb * reply = new GeoSearchReplyBb( address, bounds, locale(), _workerPool, requestPriority(), this);
+    if ( !cacheKey.isEmpty() ) {
+        reply->setCache( _geocodeCache, cacheKey );
+    }
     connectReplySignals( *reply );
     return reply;
 }
@@ -143,23 +217,93 @@ QtMobilitySubset::QGeoSearchReply* GeoSearchManagerEngineBb::geocode(const QtMob
 QtMobilitySubset::QGeoSearchReply* GeoSearchManagerEngineBb::reverseGeocode(const QtMobilitySubset::QGeoCoordinate &coordinate,
         QtMobilitySubset::QGeoBoundingArea *bounds)
 {
-    // To support the boundary specification that can be handled by the BB10 backend server, check the parent QGeoSearchManager
-    // to see if a (dynamic) "boundary" property has been set. If so, and it is valid, use it to perform the reverse geocoding.
-    // Otherwise the default is GEO_SEARCH_BOUNDARY_ADDRESS
-    geo_search_boundary_t boundaryType = GEO_SEARCH_BOUNDARY_ADDRESS;
-    QtMobilitySubset::QGeoSearchManager * searchManager = qobject_cast<QtMobilitySubset::QGeoSearchManager *>(parent());
-    if ( searchManager ) {
-        QVariant variant = searchManager->property( "boundary" );
-        if ( variant.isValid() && variant.type() == QVariant::String ) {
-            boundaryType = stringToBoundaryMap.value( variant.toString(), boundaryType );
+    geo_search_boundary_t boundaryType = requestBoundary();
+
+    // Answer repeated requests for the same place from the cache; the bounds are applied to the cached places by the reply.
+    QString cacheKey = reverseGeocodeCacheKey( coordinate, boundaryType );
+    if ( !cacheKey.isEmpty() ) {
+        QList<QtMobilitySubset::QGeoPlace> cachedPlaces;
+        if ( _reverseGeocodeCache->find( cacheKey, &cachedPlaces ) ) {
+            QtMobilitySubset::QGeoSearchReply * reply = new GeoSearchReplyBb( cachedPlaces, bounds, this );
+            connectReplySignals( *reply );
+            return reply;
         }
     }
 
-    QtMobilitySubset::QGeoSearchReply * reply = new GeoSearchReplyBb( coordinate, boundaryType, bounds, this);
+    GeoSearchReplyBb * reply = new GeoSearchReplyBb( coordinate, boundaryType, bounds, locale(), _workerPool, requestPriority(), this);
+    if ( !cacheKey.isEmpty() ) {
+        reply->setCache( _reverseGeocodeCache, cacheKey );
+    }
     connectReplySignals( *reply );
     return reply;
 }
 
+/*!
+    Begins the geocoding of each of \a addresses.
+
+    The addresses found in the geocoding cache are answered from it. The others are sent to the georeg service in
+    chunks of "batch.chunksize" addresses, which are queued behind the requests made with geocode() and are sent by
+    several threads of the worker pool at the same time over pooled georeg handles. The results of each chunk are
+    announced as it is answered, and are stored in the cache.
+
+    If \a bounds is non-null and a valid QGeoBoundingArea its centre is used as a hint where to search for every
+    address, and the results are limited to those that are contained by \a bounds.
+
+    The user is responsible for deleting the returned reply object.
+*/
+QtMobilitySubset::QGeoSearchBatchReply* GeoSearchManagerEngineBb::geocodeBatch(const QList<QtMobilitySubset::QGeoAddress> &addresses,
+        QtMobilitySubset::QGeoBoundingArea *bounds)
+{
+    GeoSearchBatchReplyBb * reply = new GeoSearchBatchReplyBb( addresses.size(), bounds, this );
+
+    for ( int i = 0 ; i < addresses.size() ; i++ ) {
+        QString cacheKey = geocodeCacheKey( addresses.at(i), bounds );
+        QList<QtMobilitySubset::QGeoPlace> cachedPlaces;
+        if ( !cacheKey.isEmpty() && _geocodeCache->find( cacheKey, &cachedPlaces ) ) {
+            reply->setCachedPlaces( i, cachedPlaces );
+        } else {
+            reply->addRequest( i, GeoSearchReplyBb::geocodeRequest( addresses.at(i), bounds, locale() ), cacheKey );
+        }
+    }
+
+    reply->start( _workerPool, _geocodeCache, _batchChunkSize );
+    return reply;
+}
+
+/*!
+    Begins the reverse geocoding of each of \a coordinates, to the boundary given by the "boundary" property of the
+    parent QGeoSearchManager as for reverseGeocode().
+
+    The coordinates found in the reverse geocoding cache are answered from it. The others are sent to the georeg
+    service in chunks of "batch.chunksize" coordinates, which are queued behind the requests made with
+    reverseGeocode() and are sent by several threads of the worker pool at the same time over pooled georeg
+    handles. The results of each chunk are announced as it is answered, and are stored in the cache.
+
+    If \a bounds is non-null and a valid QGeoBoundingArea the results are limited to those that are contained by
+    \a bounds.
+
+    The user is responsible for deleting the returned reply object.
+*/
+QtMobilitySubset::QGeoSearchBatchReply* GeoSearchManagerEngineBb::reverseGeocodeBatch(const QList<QtMobilitySubset::QGeoCoordinate> &coordinates,
+        QtMobilitySubset::QGeoBoundingArea *bounds)
+{
+    GeoSearchBatchReplyBb * reply = new GeoSearchBatchReplyBb( coordinates.size(), bounds, this );
+    geo_search_boundary_t boundaryType = requestBoundary();
+
+    for ( int i = 0 ; i < coordinates.size() ; i++ ) {
+        QString cacheKey = reverseGeocodeCacheKey( coordinates.at(i), boundaryType );
+        QList<QtMobilitySubset::QGeoPlace> cachedPlaces;
+        if ( !cacheKey.isEmpty() && _reverseGeocodeCache->find( cacheKey, &cachedPlaces ) ) {
+            reply->setCachedPlaces( i, cachedPlaces );
+        } else {
+            reply->addRequest( i, GeoSearchReplyBb::reverseGeocodeRequest( coordinates.at(i), boundaryType, locale() ), cacheKey );
+        }
+    }
+
+    reply->start( _workerPool, _reverseGeocodeCache, _batchChunkSize );
+    return reply;
+}
+
 // A QGeoSearchReply instance has emitted its finished() signal, emit this GeoSearchManagerEngineBb instance's
 // finished(const QGeoSearchReply &) signal.
 void GeoSearchManagerEngineBb::replyFinishedSignalEmitted()
@@ -201,6 +345,160 @@ void GeoSearchManagerEngineBb::connectReplySignals( const QtMobilitySubset::QGeo
     }
 }
 
+// To support the boundary specification that can be handled by the BB10 backend server, check the parent QGeoSearchManager
+// to see if a (dynamic) "boundary" property has been set. If so, and it is valid, use it to perform the reverse geocoding.
+// Otherwise the default is GEO_SEARCH_BOUNDARY_ADDRESS
+geo_search_boundary_t GeoSearchManagerEngineBb::requestBoundary() const
+{
+    geo_search_boundary_t boundaryType = GEO_SEARCH_BOUNDARY_ADDRESS;
+    QtMobilitySubset::QGeoSearchManager * searchManager = qobject_cast<QtMobilitySubset::QGeoSearchManager *>(parent());
+    if ( searchManager ) {
+        QVariant variant = searchManager->property( "boundary" );
+        if ( variant.isValid() && variant.type() == QVariant::String ) {
+            boundaryType = stringToBoundaryMap.value( variant.toString(), boundaryType );
+        }
+    }
+    return boundaryType;
+}
+
+// The key address is cached under, or an empty string if the cache is disabled. The key is the query text as sent to
+// the georeg service, case folded, the geohash cell of the hint taken from the bounds and the locale.
+QString GeoSearchManagerEngineBb::geocodeCacheKey( const QtMobilitySubset::QGeoAddress & address,
+                                                   const QtMobilitySubset::QGeoBoundingArea * bounds ) const
+{
+    if ( !_geocodeCache->isEnabled() ) {
+        return QString();
+    }
+
+    QtMobilitySubset::QGeoCoordinate hintCoordinate = GeoSearchReplyBb::coordinateHint( bounds );
+    return QString( "%1|%2|%3" ).arg( GeoSearchReplyBb::geocodeQuery( address ).toCaseFolded() )
+                                .arg( QtMobilitySubset::QGeoCellKey::geohash( hintCoordinate, _geocodeCacheHintPrecision ) )
+                                .arg( locale().name() );
+}
+
+// The key coordinate is cached under, or an empty string if the cache is disabled. The key is the coordinate quantized
+// to a geohash cell, the boundary and the locale.
+QString GeoSearchManagerEngineBb::reverseGeocodeCacheKey( const QtMobilitySubset::QGeoCoordinate & coordinate,
+                                                          geo_search_boundary_t boundary ) const
+{
+    if ( !_reverseGeocodeCache->isEnabled() || !coordinate.isValid() ) {
+        return QString();
+    }
+
+    return QString( "%1|%2|%3" ).arg( QtMobilitySubset::QGeoCellKey::geohash( coordinate, _reverseGeocodeCachePrecision ) )
+                                .arg( int( boundary ) )
+                                .arg( locale().name() );
+}
+
+// Requests are queued behind all others if the parent QGeoSearchManager has a (dynamic) "priority" property set to
+// "background", e.g. when prefetching places the user has not asked for yet. They are interactive otherwise.
+GeoSearchWorkerPoolBb::Priority GeoSearchManagerEngineBb::requestPriority() const
+{
+    QtMobilitySubset::QGeoSearchManager * searchManager = qobject_cast<QtMobilitySubset::QGeoSearchManager *>(parent());
+    if ( searchManager && searchManager->property( "priority" ).toString() == "background" ) {
+        return GeoSearchWorkerPoolBb::BackgroundPriority;
+    }
+    return GeoSearchWorkerPoolBb::InteractivePriority;
+}
+
+// SLOT
+void GeoSearchManagerEngineBb::closeIdleHandles()
+{
+    _handlePool->closeIdleHandles();
+}
+
+// SLOT
+void GeoSearchManagerEngineBb::compactStore()
+{
+    if ( _store->needsCompaction() ) {
+        _store->compact();
+    }
+}
+
+// The number of requests waiting for a thread of the worker pool.
+int GeoSearchManagerEngineBb::requestQueueDepth() const
+{
+    return _workerPool->queueDepth();
+}
+
+// The average time, in milliseconds, requests waited for a thread of the worker pool.
+double GeoSearchManagerEngineBb::requestWaitTime() const
+{
+    return _workerPool->averageWaitTime();
+}
+
+// The longest time, in milliseconds, a request waited for a thread of the worker pool.
+double GeoSearchManagerEngineBb::maximumRequestWaitTime() const
+{
+    return _workerPool->maximumWaitTime();
+}
+
+// The number of requests that shared the georeg call of an identical request that was already in flight.
+qulonglong GeoSearchManagerEngineBb::sharedRequests() const
+{
+    return _workerPool->sharedRequests();
+}
+
+// The number of requests that were aborted or deleted while they were queued, so never sent to the georeg service.
+qulonglong GeoSearchManagerEngineBb::canceledQueuedRequests() const
+{
+    return _workerPool->canceledQueuedRequests();
+}
+
+// The number of requests that were aborted or deleted while the georeg service was answering them.
+qulonglong GeoSearchManagerEngineBb::canceledRunningRequests() const
+{
+    return _workerPool->canceledRunningRequests();
+}
+
+// The number of places in georeg replies that were not read because their requests were canceled.
+qulonglong GeoSearchManagerEngineBb::canceledPlaces() const
+{
+    return _workerPool->canceledPlaces();
+}
+
+// The average time, in milliseconds, requests waited for a georeg handle, including the time to open it.
+double GeoSearchManagerEngineBb::handleAcquisitionTime() const
+{
+    return _handlePool->averageAcquisitionTime();
+}
+
+// The longest time, in milliseconds, a request waited for a georeg handle.
+double GeoSearchManagerEngineBb::maximumHandleAcquisitionTime() const
+{
+    return _handlePool->maximumAcquisitionTime();
+}
+
+// The number of geocoding and reverse geocoding requests that were answered from the store on disk.
+qulonglong GeoSearchManagerEngineBb::storeHits() const
+{
+    return _store ? _store->hits() : 0;
+}
+
+// The number of geocoding requests that were answered from the cache.
+qulonglong GeoSearchManagerEngineBb::geocodeCacheHits() const
+{
+    return _geocodeCache->hits();
+}
+
+// The number of geocoding requests that were looked up in the cache and sent to the georeg service.
+qulonglong GeoSearchManagerEngineBb::geocodeCacheMisses() const
+{
+    return _geocodeCache->misses();
+}
+
+// The number of reverse geocoding requests that were answered from the cache.
+qulonglong GeoSearchManagerEngineBb::reverseGeocodeCacheHits() const
+{
+    return _reverseGeocodeCache->hits();
+}
+
+// The number of reverse geocoding requests that were looked up in the cache and sent to the georeg service.
+qulonglong GeoSearchManagerEngineBb::reverseGeocodeCacheMisses() const
+{
+    return _reverseGeocodeCache->misses();
+}
+
 } // namespace
 } // namespace
 } // namespace
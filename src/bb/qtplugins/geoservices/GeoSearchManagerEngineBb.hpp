@@ -8,11 +8,17 @@
 #ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHMANAGERENGINEBB_HPP
 #define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHMANAGERENGINEBB_HPP
 
+#include "GeoSearchCacheBb.hpp"
+#include "GeoSearchHandlePoolBb.hpp"
+#include "GeoSearchWorkerPoolBb.hpp"
+
 #include <QGeoSearchManagerEngine>
 
 #include <QObject>
 #include <QScopedPointer>
+#include <QSharedPointer>
 #include <QList>
+#include <QTimer>
 
 // The following using statement is necessary so the SIGNAL()/SLOT() macros can have matching signatures.
 // This avoids a namespace mismatch that throws off connect().
@@ -25,9 +31,52 @@ namespace qtplugins
 namespace geoservices
 {
 
+/**
+ * The search manager engine of the BB10 geoservices plugin.
+ *
+ * The engine takes the following parameters from the parameter map passed to the QGeoServiceProvider constructor:
+ *
+ * - "workerpool.size": the maximum number of georeg requests sent at the same time, 4 by default. The other requests
+ *   wait in a queue. Requests made while the QGeoSearchManager has a (dynamic) "priority" property set to "background"
+ *   wait behind all the others; requests are interactive otherwise. A request that is the same as one already in
+ *   flight (the same query or coordinate, boundary, hint and locale) shares its georeg call.
+ * - "places.chunksize": the number of places of a reply that are added to the QGeoSearchReply together, announced
+ *   by its placesAdded() signal, while the rest are still read; 10 by default. 0 adds all the places at once.
+ * - "batch.chunksize": the number of addresses or coordinates of a batch that a thread of the worker pool sends one
+ *   after the other, 25 by default. The chunks of a batch are background requests.
+ * - "handlepool.size": the maximum number of georeg handles open at the same time, 4 by default. Requests wait for a
+ *   handle when all of them are in use.
+ * - "handlepool.idletimeout": the number of seconds an unused georeg handle is kept open for, 60 by default.
+ * - "geocode.cache.size": the number of geocoding results to keep, 500 by default. 0 disables the cache.
+ * - "geocode.cache.ttl": the number of seconds a geocoding result is used for, 3600 by default.
+ * - "geocode.cache.hintprecision": the length of the geohash the centre of the bounds, which georeg takes as a hint
+ *   where to search, is quantized to when it is looked up in the cache, 5 (about 5 by 5 kilometres) by default.
+ * - "reversegeocode.cache.size": the number of reverse geocoding results to keep, 100 by default. 0 disables the cache.
+ * - "reversegeocode.cache.ttl": the number of seconds a reverse geocoding result is used for, 300 by default.
+ * - "reversegeocode.cache.precision": the length of the geohash the coordinate is quantized to when it is looked up in
+ *   the cache, 9 (about 5 by 5 metres) by default. Coordinates in the same cell share their result.
+ * - "cache.store.path": the path, without extension, of the files of a GeoSearchStoreBb that keeps the entries of
+ *   both caches across restarts. Not set by default, which keeps the caches in memory only.
+ * - "cache.store.maxsize": the size in bytes the store is compacted at, 4 MB by default and at least 64 KB. The
+ *   engine checks the size of the store every 30 seconds, and compacts it then.
+ */
 class GeoSearchManagerEngineBb : public QtMobilitySubset::QGeoSearchManagerEngine
 {
     Q_OBJECT
+    Q_PROPERTY(int requestQueueDepth READ requestQueueDepth)
+    Q_PROPERTY(double requestWaitTime READ requestWaitTime)
+    Q_PROPERTY(double maximumRequestWaitTime READ maximumRequestWaitTime)
+    Q_PROPERTY(qulonglong sharedRequests READ sharedRequests)
+    Q_PROPERTY(qulonglong canceledQueuedRequests READ canceledQueuedRequests)
+    Q_PROPERTY(qulonglong canceledRunningRequests READ canceledRunningRequests)
+    Q_PROPERTY(qulonglong canceledPlaces READ canceledPlaces)
+    Q_PROPERTY(double handleAcquisitionTime READ handleAcquisitionTime)
+    Q_PROPERTY(double maximumHandleAcquisitionTime READ maximumHandleAcquisitionTime)
+    Q_PROPERTY(qulonglong storeHits READ storeHits)
+    Q_PROPERTY(qulonglong geocodeCacheHits READ geocodeCacheHits)
+    Q_PROPERTY(qulonglong geocodeCacheMisses READ geocodeCacheMisses)
+    Q_PROPERTY(qulonglong reverseGeocodeCacheHits READ reverseGeocodeCacheHits)
+    Q_PROPERTY(qulonglong reverseGeocodeCacheMisses READ reverseGeocodeCacheMisses)
 public:
     GeoSearchManagerEngineBb(const QMap<QString, QVariant> &parameters, QObject *parent = 0);
     virtual ~GeoSearchManagerEngineBb();
@@ -37,14 +86,54 @@ public:
     virtual QtMobilitySubset::QGeoSearchReply* reverseGeocode(const QtMobilitySubset::QGeoCoordinate &coordinate,
             QtMobilitySubset::QGeoBoundingArea *bounds);
 
+    virtual QtMobilitySubset::QGeoSearchBatchReply* geocodeBatch(const QList<QtMobilitySubset::QGeoAddress> &addresses,
+            QtMobilitySubset::QGeoBoundingArea *bounds);
+    virtual QtMobilitySubset::QGeoSearchBatchReply* reverseGeocodeBatch(const QList<QtMobilitySubset::QGeoCoordinate> &coordinates,
+            QtMobilitySubset::QGeoBoundingArea *bounds);
+
     void    connectReplySignals( const QtMobilitySubset::QGeoSearchReply & reply );
 
+    int requestQueueDepth() const;
+    double requestWaitTime() const;
+    double maximumRequestWaitTime() const;
+    qulonglong sharedRequests() const;
+    qulonglong canceledQueuedRequests() const;
+    qulonglong canceledRunningRequests() const;
+    qulonglong canceledPlaces() const;
+    double handleAcquisitionTime() const;
+    double maximumHandleAcquisitionTime() const;
+    qulonglong storeHits() const;
+    qulonglong geocodeCacheHits() const;
+    qulonglong geocodeCacheMisses() const;
+    qulonglong reverseGeocodeCacheHits() const;
+    qulonglong reverseGeocodeCacheMisses() const;
+
 public Q_SLOTS:
     void replyFinishedSignalEmitted();
     void replyErrorSignalEmitted( QGeoSearchReply::Error error, const QString & errorString );
 
+private Q_SLOTS:
+    void closeIdleHandles();
+    void compactStore();
+
 private:
     Q_DISABLE_COPY(GeoSearchManagerEngineBb)
+
+    GeoSearchWorkerPoolBb::Priority requestPriority() const;
+    geo_search_boundary_t requestBoundary() const;
+    QString geocodeCacheKey( const QtMobilitySubset::QGeoAddress & address, const QtMobilitySubset::QGeoBoundingArea * bounds ) const;
+    QString reverseGeocodeCacheKey( const QtMobilitySubset::QGeoCoordinate & coordinate, geo_search_boundary_t boundary ) const;
+
+    QSharedPointer<GeoSearchHandlePoolBb> _handlePool;
+    QTimer _idleHandleTimer;
+    QSharedPointer<GeoSearchWorkerPoolBb> _workerPool;
+    int _batchChunkSize;
+    QSharedPointer<GeoSearchStoreBb> _store;
+    QTimer _storeCompactionTimer;
+    QSharedPointer<GeoSearchCacheBb> _geocodeCache;
+    int _geocodeCacheHintPrecision;
+    QSharedPointer<GeoSearchCacheBb> _reverseGeocodeCache;
+    int _reverseGeocodeCachePrecision;
 };
 
 }
@@ -6,11 +6,12 @@
 
 #include "GeoSearchReplyBb.hpp"
 
+#include <QGeoPreparedCircle>
+
 #include <QList>
 #include <QtDebug>
-#include <QtConcurrentRun>
 
-using bb::qtplugins::geoservices::GeoregReply;
+using bb::qtplugins::geoservices::GeoregRequest;
 
 namespace
 {
@@ -53,26 +54,12 @@ QMap<geo_search_error_t, QtMobilitySubset::QGeoSearchReply::Error> createGeoSear
 const QMap<geo_search_error_t, QtMobilitySubset::QGeoSearchReply::Error> geoSearchReplyErrorMap = createGeoSearchReplyErrorMap();
 
 
-// take the centre of the bounds as an indication of where to search near. Useful for geocoding.
-QtMobilitySubset::QGeoCoordinate coordinateHint( const QtMobilitySubset::QGeoBoundingArea * bounds )
-{
-    QtMobilitySubset::QGeoCoordinate centre;
-
-    // optional hint
-    if ( bounds && bounds->isValid() ) {
-        // use the bounds centre as a hint where to look
-        if ( bounds->type() == QtMobilitySubset::QGeoBoundingArea::BoxType ) {
-            centre = ( static_cast<const QtMobilitySubset::QGeoBoundingBox*>(bounds))->center();
-        } else if ( bounds->type() == QtMobilitySubset::QGeoBoundingArea::CircleType ) {
-            centre = ( static_cast<const QtMobilitySubset::QGeoBoundingCircle*>(bounds))->center();
-        }
-    }
-
-    return centre;
-}
-
 // retrieves the list of places found by the georeg service and puts them in a QList<QtMobilitySubset::QGeoPlace>.
-geo_search_error_t populatePlaces( bbmock::GeoregApi & georegApi, QList<QtMobilitySubset::QGeoPlace> * places, geo_search_reply_t reply )
+// Stops early, leaving the number of places not read in skipped, if future is canceled. If chunkSize is not 0, every
+// chunkSize places are handed to future as soon as they are read, leaving the number handed over in reported.
+geo_search_error_t populatePlaces( bbmock::GeoregApi & georegApi, QList<QtMobilitySubset::QGeoPlace> * places, geo_search_reply_t reply,
+                                   QFutureInterface<bb::qtplugins::geoservices::GeoregReply> * future, int * skipped,
+                                   int chunkSize, int * reported )
 {
     geo_search_error_t err = GEO_SEARCH_OK;
     int numPlaces;
@@ -84,6 +71,13 @@ geo_search_error_t populatePlaces( bbmock::GeoregApi & georegApi, QList<QtMobili
 
     for ( int i = 0 ; i < numPlaces ; i++ )
     {
+        if ( future && future->isCanceled() ) {
+            if ( skipped ) {
+                *skipped = numPlaces - i;
+            }
+            return GEO_SEARCH_OK;
+        }
+
         const char * string;
         double number;
 
@@ -155,76 +149,37 @@ geo_search_error_t populatePlaces( bbmock::GeoregApi & georegApi, QList<QtMobili
         place.setAddress( address );
 
         places->append( place );
+
+        // the list is handed over rather than copied; the places that follow start a new one.
+        if ( future && chunkSize > 0 && places->size() == chunkSize && i < numPlaces - 1 ) {
+            bb::qtplugins::geoservices::GeoregReply chunk;
+            chunk.error = QtMobilitySubset::QGeoSearchReply::NoError;
+            chunk.places.swap( *places );
+            future->reportResult( chunk );
+            *reported += chunk.places.size();
+        }
     }
 
     // success if execution makes it here
     return GEO_SEARCH_OK;
 }
 
-// This function is blocking and is meant to run in a separate thread using QFuture and QtConcurrent::run()
-GeoregReply geocode( const QtMobilitySubset::QGeoAddress &address, const QtMobilitySubset::QGeoCoordinate & hintCoordinate )
+// sends request on handle. This step is potentially blocking.
+geo_search_error_t sendRequest( bbmock::GeoregApi & georegApi, geo_search_handle_t * handle, geo_search_reply_t * reply,
+                                const GeoregRequest & request )
 {
-    bbmock::GeoregApi & georegApi = bbmock::GeoregApi::getInstance();
-    GeoregReply georegReply;
-
-    geo_search_handle_t geoServiceHandle;
-    geo_search_error_t err = georegApi.geo_search_open( &geoServiceHandle );
-    if ( err == GEO_SEARCH_OK ) {
-        // Since the georeg service is limited to free-form text string searches use the address.text() field as the input.
-        // This is advantageous since if the QGeoAddress text field was not directly set by the caller a string is auto-generated
-        // in the call to QGeoAddress::text(), which consists of the other QGeoAddress fields structured into a country
-        // code-dependent address string.
-        // remove extraneous whitespace from the address.text() string, particularly '\n' that are present when the text is
-        // auto-generated from the other address fields.
-        QByteArray simplifiedAddress = address.text().simplified().toUtf8();
-
-        geo_search_reply_t reply;
-        // this step is potentially blocking
-        if ( hintCoordinate.isValid() ) {
-            err = georegApi.geo_search_geocode_latlon( &geoServiceHandle, &reply, simplifiedAddress.constData(), hintCoordinate.latitude(), hintCoordinate.longitude() );
-        } else {
-            err = georegApi.geo_search_geocode( &geoServiceHandle, &reply, simplifiedAddress.constData() );
-        }
-
-        if ( err == GEO_SEARCH_OK ) {
-            err = populatePlaces( georegApi, &georegReply.places, reply );
-            georegApi.geo_search_free_reply( &reply );
-        }
+    if ( request.reverse ) {
+        return georegApi.geo_search_reverse_geocode( handle,
+                                                     reply,
+                                                     request.coordinate.latitude(),
+                                                     request.coordinate.longitude(),
+                                                     request.boundary );
     }
-    georegReply.error = geoSearchReplyErrorMap.value( err );
-
-    georegApi.geo_search_close( &geoServiceHandle );
 
-    return georegReply;
-}
-
-// This function is blocking and is meant to run in a separate thread using QFuture and QtConcurrent::run()
-GeoregReply reverseGeocode( const QtMobilitySubset::QGeoCoordinate &coordinate, geo_search_boundary_t boundary )
-{
-    bbmock::GeoregApi & georegApi = bbmock::GeoregApi::getInstance();
-    GeoregReply georegReply;
-
-    geo_search_handle_t geoServiceHandle;
-    geo_search_error_t err = georegApi.geo_search_open( &geoServiceHandle );
-    if ( err == GEO_SEARCH_OK ) {
-        geo_search_reply_t reply;
-
-        // this line is potentially blocking
-        err = georegApi.geo_search_reverse_geocode( &geoServiceHandle,
-                                                    &reply,
-                                                    coordinate.latitude(),
-                                                    coordinate.longitude(),
-                                                    boundary );
-        if ( err == GEO_SEARCH_OK ) {
-            err = populatePlaces( georegApi, &georegReply.places, reply );
-            georegApi.geo_search_free_reply( &reply );
-        }
+    if ( request.coordinate.isValid() ) {
+        return georegApi.geo_search_geocode_latlon( handle, reply, request.searchString.constData(), request.coordinate.latitude(), request.coordinate.longitude() );
     }
-    georegReply.error = geoSearchReplyErrorMap.value( err );
-
-    georegApi.geo_search_close( &geoServiceHandle );
-
-    return georegReply;
+    return georegApi.geo_search_geocode( handle, reply, request.searchString.constData() );
 }
 
 }
@@ -237,34 +192,70 @@ namespace geoservices
 {
 
 // create a search reply for a geocode request
-GeoSearchReplyBb::GeoSearchReplyBb(const QtMobilitySubset::QGeoAddress &address, const QtMobilitySubset::QGeoBoundingArea * bounds, QObject * parent )
+GeoSearchReplyBb::GeoSearchReplyBb(const QtMobilitySubset::QGeoAddress &address, const QtMobilitySubset::QGeoBoundingArea * bounds,
+                                   const QLocale & locale, const QSharedPointer<GeoSearchWorkerPoolBb> & workerPool,
+                                   GeoSearchWorkerPoolBb::Priority priority, QObject * parent )
     : QGeoSearchReply(parent),
+      _receivedError(QtMobilitySubset::QGeoSearchReply::NoError),
+      _shared(false),
       _bounds(NULL)
 {
     if ( !initialize( bounds ) ) {
         return;
     }
 
-    QtMobilitySubset::QGeoCoordinate hintCoordinate = coordinateHint( bounds );
+    GeoregRequest request = geocodeRequest( address, bounds, locale );
 
-    _future = QtConcurrent::run( geocode, address, hintCoordinate );
+    // an identical request that is already in flight is shared rather than sent again; the bounds of this reply
+    // are still applied to its places.
+    _future = workerPool->submit( request, priority, &_shared );
     _futureWatcher.setFuture( _future );
+    _workerPool = workerPool;
 }
 
 // create a search reply for a reverse geocode request
 GeoSearchReplyBb::GeoSearchReplyBb(const QtMobilitySubset::QGeoCoordinate &coordinate,
                                    geo_search_boundary_t boundary,
                                    const QtMobilitySubset::QGeoBoundingArea * bounds,
+                                   const QLocale & locale,
+                                   const QSharedPointer<GeoSearchWorkerPoolBb> & workerPool,
+                                   GeoSearchWorkerPoolBb::Priority priority,
                                    QObject * parent )
     : QGeoSearchReply(parent),
+      _receivedError(QtMobilitySubset::QGeoSearchReply::NoError),
+      _shared(false),
       _bounds(NULL)
 {
     if ( !initialize( bounds ) ) {
         return;
     }
 
-    _future = QtConcurrent::run( reverseGeocode, coordinate, boundary );
+    GeoregRequest request = reverseGeocodeRequest( coordinate, boundary, locale );
+
+    // an identical request that is already in flight is shared rather than sent again; the bounds of this reply
+    // are still applied to its places.
+    _future = workerPool->submit( request, priority, &_shared );
     _futureWatcher.setFuture( _future );
+    _workerPool = workerPool;
+}
+
+// create a search reply that is answered with places taken from a cache
+GeoSearchReplyBb::GeoSearchReplyBb(const QList<QtMobilitySubset::QGeoPlace> & cachedPlaces,
+                                   const QtMobilitySubset::QGeoBoundingArea * bounds,
+                                   QObject * parent )
+    : QGeoSearchReply(parent),
+      _cachedPlaces(cachedPlaces),
+      _receivedError(QtMobilitySubset::QGeoSearchReply::NoError),
+      _shared(false),
+      _bounds(NULL)
+{
+    if ( !initialize( bounds ) ) {
+        return;
+    }
+
+    // finish on the next turn of the event loop, as a reply from the georeg service would, so that the caller
+    // has the chance to connect to the signals first.
+    QMetaObject::invokeMethod( this, "receiveCachedReply", Qt::QueuedConnection );
 }
 
 /*!
@@ -272,17 +263,20 @@ GeoSearchReplyBb::GeoSearchReplyBb(const QtMobilitySubset::QGeoCoordinate &coord
 */
 GeoSearchReplyBb::~GeoSearchReplyBb()
 {
+    // nobody is interested in the places any more.
+    cancelRequest();
 }
 
-// store the bounds and connect the future watcher to receiveReply()
+// store the bounds and connect the future watcher to receivePlaces() and receiveReply()
 bool GeoSearchReplyBb::initialize( const QtMobilitySubset::QGeoBoundingArea *bounds )
 {
     // the BB Geocode Service does not provide bounding of the request so the bounds are
     // saved here for filtering of the BB Geocode Service reply manually.
     setBounds( bounds );
 
-    // connect the future watcher to receiveReply()
-    bool connected = connect( &_futureWatcher, SIGNAL(finished()), SLOT(receiveReply()) );
+    // connect the future watcher to receivePlaces(), for the parts of the reply, and receiveReply()
+    bool connected = connect( &_futureWatcher, SIGNAL(resultsReadyAt(int, int)), SLOT(receivePlaces(int, int)) )
+                  && connect( &_futureWatcher, SIGNAL(finished()), SLOT(receiveReply()) );
     if ( !connected ) {
         finishReply( QtMobilitySubset::QGeoSearchReply::CommunicationError );
         return false;
@@ -292,40 +286,226 @@ bool GeoSearchReplyBb::initialize( const QtMobilitySubset::QGeoBoundingArea *bou
 }
 
 
+// take the centre of the bounds as an indication of where to search near. Useful for geocoding.
+QtMobilitySubset::QGeoCoordinate GeoSearchReplyBb::coordinateHint( const QtMobilitySubset::QGeoBoundingArea * bounds )
+{
+    QtMobilitySubset::QGeoCoordinate centre;
+
+    // optional hint
+    if ( bounds && bounds->isValid() ) {
+        // use the bounds centre as a hint where to look
+        if ( bounds->type() == QtMobilitySubset::QGeoBoundingArea::BoxType ) {
+            centre = ( static_cast<const QtMobilitySubset::QGeoBoundingBox*>(bounds))->center();
+        } else if ( bounds->type() == QtMobilitySubset::QGeoBoundingArea::CircleType ) {
+            centre = ( static_cast<const QtMobilitySubset::QGeoBoundingCircle*>(bounds))->center();
+        }
+    }
+
+    return centre;
+}
+
+// The text the georeg service is asked to geocode for address.
+QString GeoSearchReplyBb::geocodeQuery( const QtMobilitySubset::QGeoAddress & address )
+{
+    // Since the georeg service is limited to free-form text string searches use the address.text() field as the input.
+    // This is advantageous since if the QGeoAddress text field was not directly set by the caller a string is auto-generated
+    // in the call to QGeoAddress::text(), which consists of the other QGeoAddress fields structured into a country
+    // code-dependent address string.
+    // remove extraneous whitespace from the address.text() string, particularly '\n' that are present when the text is
+    // auto-generated from the other address fields.
+    return address.text().simplified();
+}
+
+// The request to the georeg service that geocodes address.
+GeoregRequest GeoSearchReplyBb::geocodeRequest( const QtMobilitySubset::QGeoAddress & address,
+                                                const QtMobilitySubset::QGeoBoundingArea * bounds,
+                                                const QLocale & locale )
+{
+    GeoregRequest request;
+    request.reverse = false;
+    request.searchString = geocodeQuery( address ).toUtf8();
+    request.coordinate = coordinateHint( bounds );
+    request.boundary = GEO_SEARCH_BOUNDARY_ADDRESS;
+    request.locale = locale.name();
+    return request;
+}
+
+// The request to the georeg service that reverse geocodes coordinate.
+GeoregRequest GeoSearchReplyBb::reverseGeocodeRequest( const QtMobilitySubset::QGeoCoordinate & coordinate,
+                                                       geo_search_boundary_t boundary,
+                                                       const QLocale & locale )
+{
+    GeoregRequest request;
+    request.reverse = true;
+    request.coordinate = coordinate;
+    request.boundary = boundary;
+    request.locale = locale.name();
+    return request;
+}
+
+// This function is blocking and is meant to run on a thread of a GeoSearchWorkerPoolBb
+GeoregReply GeoSearchReplyBb::runRequest( const GeoregRequest & request,
+                                          const QSharedPointer<GeoSearchHandlePoolBb> & handlePool,
+                                          QFutureInterface<GeoregReply> * future, int * skippedPlaces, int chunkSize )
+{
+    bbmock::GeoregApi & georegApi = bbmock::GeoregApi::getInstance();
+    GeoregReply georegReply;
+
+    geo_search_error_t err = GEO_SEARCH_OK;
+    bool reused;
+    int reportedPlaces = 0;
+    do {
+        geo_search_handle_t geoServiceHandle;
+        err = handlePool->acquire( &geoServiceHandle, &reused );
+        if ( err != GEO_SEARCH_OK ) {
+            break;
+        }
+
+        // the request was canceled while it waited for a handle.
+        if ( future && future->isCanceled() ) {
+            handlePool->release( geoServiceHandle, false );
+            break;
+        }
+
+        geo_search_reply_t reply;
+        err = sendRequest( georegApi, &geoServiceHandle, &reply, request );
+        if ( err == GEO_SEARCH_OK ) {
+            georegReply.places.clear();
+            err = populatePlaces( georegApi, &georegReply.places, reply, future, skippedPlaces, chunkSize, &reportedPlaces );
+            georegApi.geo_search_free_reply( &reply );
+        }
+
+        // a pooled handle may have lost its connection to the server while it was idle, so a server error on it
+        // is retried on another handle, until one that was just opened fails too. Once places have been reported
+        // a retry would report them again.
+        handlePool->release( geoServiceHandle, GeoSearchHandlePoolBb::isHandleError( err ) );
+    } while ( reused && GeoSearchHandlePoolBb::isHandleError( err ) && reportedPlaces == 0 && !( future && future->isCanceled() ) );
+
+    georegReply.error = geoSearchReplyErrorMap.value( err );
+
+    return georegReply;
+}
+
+/*!
+    Cancels the request. If it is still queued it is never sent to the georeg service; if it is running the places
+    of its reply are not read. Either way this reply emits no further signals.
+*/
+void GeoSearchReplyBb::abort()
+{
+    if ( isFinished() ) {
+        return;
+    }
+
+    cancelRequest();
+    QGeoSearchReply::abort();
+}
+
+// Withdraw the request from the worker pool, which cancels it unless other replies share it, and stop watching it.
+void GeoSearchReplyBb::cancelRequest()
+{
+    if ( !_workerPool ) {
+        return;
+    }
+
+    _futureWatcher.disconnect( this );
+    _workerPool->cancel( _future );
+    _workerPool.clear();
+}
+
+// SLOT
+void GeoSearchReplyBb::receivePlaces( int begin, int end )
+{
+    for ( int i = begin ; i < end ; i++ ) {
+        // Get the next (unbounded) part of the list of places from the future (this is exciting!)
+        GeoregReply georegReply = _future.resultAt( i );
+
+        // only the last part can carry an error; the places that come with it are not added.
+        if ( georegReply.error != QtMobilitySubset::QGeoSearchReply::NoError ) {
+            _receivedError = georegReply.error;
+            continue;
+        }
+
+        if ( _cache && !_shared ) {
+            _receivedPlaces += georegReply.places;
+        }
+
+        // apply the bounds and add the bound subset to this GeoSearchReplyBb's places list, which emits placesAdded().
+        boundPlaces( georegReply.places );
+    }
+}
+
 // SLOT
 void GeoSearchReplyBb::receiveReply()
 {
-    // Get the (unbounded) list of places from the future (this is exciting!)
-    GeoregReply georegReply = _future.result();
+    // the worker pool was destroyed before the request was sent or while it was running, so there is no reply.
+    if ( _future.isCanceled() ) {
+        return;
+    }
 
-    if ( georegReply.error != QtMobilitySubset::QGeoSearchReply::NoError ) {
-        finishReply( georegReply.error );
+    if ( _receivedError != QtMobilitySubset::QGeoSearchReply::NoError ) {
+        _receivedPlaces.clear();
+        finishReply( _receivedError );
         return;
     }
 
-    // apply the bounds and set this GeoSearchReplyBb's places list to the bound subset.
-    boundPlaces( georegReply.places );
+    // cache the unbounded places, so that they can answer later requests with other bounds.
+    if ( _cache && !_shared ) {
+        _cache->insert( _cacheKey, _receivedPlaces );
+        _receivedPlaces.clear();
+    }
 
     // signal that the list of places is ready
     finishReply( QtMobilitySubset::QGeoSearchReply::NoError );
 }
 
-// Reduce the list of places to those that are contained within the bounds
+// SLOT
+void GeoSearchReplyBb::receiveCachedReply()
+{
+    // the reply was aborted before the cached places were delivered.
+    if ( isFinished() ) {
+        return;
+    }
+
+    boundPlaces( _cachedPlaces );
+    _cachedPlaces.clear();
+
+    finishReply( QtMobilitySubset::QGeoSearchReply::NoError );
+}
+
+// Reduce the list of places to those that are contained within the bounds, and add them to the places of the reply
 void GeoSearchReplyBb::boundPlaces( const QList<QtMobilitySubset::QGeoPlace> & unboundPlaces )
 {
-    // Bound only if the bounds are valid and not empty. If the bounds are empty the bounds area is zero, so assume the bounds
-    // are only useful for the centre location, as a hint where to search in the case of geocoding.
-    if ( _bounds && _bounds->isValid() && !_bounds->isEmpty() ) {
-        for ( int i = 0 ; i < unboundPlaces.size() ; i++ ) {
-            if ( _bounds->contains( unboundPlaces.at(i).coordinate() ) ) {
-                addPlace( unboundPlaces.at(i) );
+    addPlaces( placesWithin( unboundPlaces, _bounds ) );
+}
+
+// The places that are contained within bounds. Bound only if the bounds are valid and not empty. If the bounds are empty
+// the bounds area is zero, so assume the bounds are only useful for the centre location, as a hint where to search in
+// the case of geocoding.
+QList<QtMobilitySubset::QGeoPlace> GeoSearchReplyBb::placesWithin( const QList<QtMobilitySubset::QGeoPlace> & places,
+                                                                   const QtMobilitySubset::QGeoBoundingArea * bounds )
+{
+    if ( !bounds || !bounds->isValid() || bounds->isEmpty() ) {
+        // there are no bounds, keep all places.
+        return places;
+    }
+
+    QList<QtMobilitySubset::QGeoPlace> boundPlaces;
+    if ( bounds->type() == QtMobilitySubset::QGeoBoundingArea::CircleType ) {
+        // prepare the circle once rather than going through the bounds for every place.
+        QtMobilitySubset::QGeoPreparedCircle circle( *static_cast<const QtMobilitySubset::QGeoBoundingCircle*>(bounds) );
+        for ( int i = 0 ; i < places.size() ; i++ ) {
+            if ( circle.contains( places.at(i).coordinate() ) ) {
+                boundPlaces.append( places.at(i) );
             }
         }
     } else {
-        // there are no bounds, add all places.
-        setPlaces( unboundPlaces );
+        for ( int i = 0 ; i < places.size() ; i++ ) {
+            if ( bounds->contains( places.at(i).coordinate() ) ) {
+                boundPlaces.append( places.at(i) );
+            }
+        }
     }
-
+    return boundPlaces;
 }
 
 // Make a copy of the bounds. The QGeoSearchReply design presumes that the bounds are used as part of the request to the underlying
@@ -354,11 +534,18 @@ void GeoSearchReplyBb::setBounds( const QtMobilitySubset::QGeoBoundingArea *boun
     }
 }
 
+// Store the places in cache under key when they are received from the georeg service.
+void GeoSearchReplyBb::setCache( const QSharedPointer<GeoSearchCacheBb> & cache, const QString & key )
+{
+    _cache = cache;
+    _cacheKey = key;
+}
+
 void GeoSearchReplyBb::finishReply( QtMobilitySubset::QGeoSearchReply::Error error )
 {
     // Since QGeoSearchReply and its descendents are left to the user to destroy, release unnecessary resources now.
-    GeoregReply georegReply = _future.result();
-    georegReply.places.clear();
+    _cache.clear();
+    _workerPool.clear();
 
     if ( error == QtMobilitySubset::QGeoSearchReply::NoError ) {
         // this causes finished() to be emitted
@@ -7,6 +7,9 @@
 #ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHREPLYBB_H
 #define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHREPLYBB_H
 
+#include "GeoSearchCacheBb.hpp"
+#include "GeoSearchHandlePoolBb.hpp"
+#include "GeoSearchWorkerPoolBb.hpp"
 #include "private/bbmock/GeoregApi.hpp"
 
 #include <bb/PpsObject>
@@ -19,9 +22,14 @@
 #include <QGeoBoundingCircle>
 #include <QFutureWatcher>
 #include <QFuture>
+#include <QFutureInterface>
 
+#include <QByteArray>
 #include <QObject>
 #include <QList>
+#include <QLocale>
+#include <QSharedPointer>
+#include <QString>
 
 namespace bb
 {
@@ -30,14 +38,6 @@ namespace qtplugins
 namespace geoservices
 {
 
-typedef struct GeoregReplyStruct
-{
-    QtMobilitySubset::QGeoSearchReply::Error error;
-    QList<QtMobilitySubset::QGeoPlace> places;
-
-} GeoregReply;
-
-
 class GeoSearchReplyBb : public QtMobilitySubset::QGeoSearchReply
 {
     Q_OBJECT
@@ -46,29 +46,80 @@ public:
     // create a search reply for a geocode request
     GeoSearchReplyBb( const QtMobilitySubset::QGeoAddress &address,
                      const QtMobilitySubset::QGeoBoundingArea * bounds,
+                     const QLocale & locale,
+                     const QSharedPointer<GeoSearchWorkerPoolBb> & workerPool,
+                     GeoSearchWorkerPoolBb::Priority priority,
                      QObject * parent = 0 );
     // create a search reply for a reverse geocode request
     GeoSearchReplyBb( const QtMobilitySubset::QGeoCoordinate &coordinate,
                      geo_search_boundary_t boundary,
+                     const QtMobilitySubset::QGeoBoundingArea * bounds,
+                     const QLocale & locale,
+                     const QSharedPointer<GeoSearchWorkerPoolBb> & workerPool,
+                     GeoSearchWorkerPoolBb::Priority priority,
+                     QObject * parent = 0 );
+    // create a search reply that is answered with places taken from a cache
+    GeoSearchReplyBb( const QList<QtMobilitySubset::QGeoPlace> & cachedPlaces,
                      const QtMobilitySubset::QGeoBoundingArea * bounds,
                      QObject * parent = 0 );
 
     virtual ~GeoSearchReplyBb();
 
+    virtual void abort();
+
     bool initialize( const QtMobilitySubset::QGeoBoundingArea *bounds );
     void boundPlaces( const QList<QtMobilitySubset::QGeoPlace> & unboundPlaces );
     void setBounds( const QtMobilitySubset::QGeoBoundingArea *bounds );
     void finishReply( QtMobilitySubset::QGeoSearchReply::Error error );
+    void setCache( const QSharedPointer<GeoSearchCacheBb> & cache, const QString & key );
+
+    static QtMobilitySubset::QGeoCoordinate coordinateHint( const QtMobilitySubset::QGeoBoundingArea * bounds );
+    static QString geocodeQuery( const QtMobilitySubset::QGeoAddress & address );
+    static GeoregRequest geocodeRequest( const QtMobilitySubset::QGeoAddress & address,
+                                         const QtMobilitySubset::QGeoBoundingArea * bounds,
+                                         const QLocale & locale );
+    static GeoregRequest reverseGeocodeRequest( const QtMobilitySubset::QGeoCoordinate & coordinate,
+                                                geo_search_boundary_t boundary,
+                                                const QLocale & locale );
+    static QList<QtMobilitySubset::QGeoPlace> placesWithin( const QList<QtMobilitySubset::QGeoPlace> & places,
+                                                            const QtMobilitySubset::QGeoBoundingArea * bounds );
+
+    /**
+     * Sends request to the georeg service on a handle from handlePool and waits for the reply.
+     * This is blocking and is meant to run on a thread of a GeoSearchWorkerPoolBb.
+     *
+     * @param future If not null, the reading of places stops when it is canceled.
+     * @param skippedPlaces Set to the number of places that were not read because future was canceled.
+     * @param chunkSize If not 0, every chunkSize places read are reported to future as a reply of their own, and
+     * the returned reply holds the places that follow them.
+     */
+    static GeoregReply runRequest( const GeoregRequest & request, const QSharedPointer<GeoSearchHandlePoolBb> & handlePool,
+                                   QFutureInterface<GeoregReply> * future = 0, int * skippedPlaces = 0, int chunkSize = 0 );
 
 public Q_SLOTS:
+    void receivePlaces( int begin, int end );
     void receiveReply();
-
+    void receiveCachedReply();
 
 private:
     Q_DISABLE_COPY(GeoSearchReplyBb)
 
+    void cancelRequest();
+
     QFuture<GeoregReply> _future;
     QFutureWatcher<GeoregReply> _futureWatcher;
+    // the pool the request is queued or running on, until the reply is finished
+    QSharedPointer<GeoSearchWorkerPoolBb> _workerPool;
+    QList<QtMobilitySubset::QGeoPlace> _cachedPlaces;
+    // the (unbounded) places received so far, kept for the cache, and the error the last part of the reply carried
+    QList<QtMobilitySubset::QGeoPlace> _receivedPlaces;
+    QtMobilitySubset::QGeoSearchReply::Error _receivedError;
+
+    // the cache the places are stored in when they are received, and their key
+    QSharedPointer<GeoSearchCacheBb> _cache;
+    QString _cacheKey;
+    // whether the georeg call is shared with an earlier reply, which stores the places in the cache
+    bool _shared;
 
     QtMobilitySubset::QGeoBoundingArea * _bounds;
     QtMobilitySubset::QGeoBoundingBox _boundingBox;
@@ -0,0 +1,683 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#include "GeoSearchStoreBb.hpp"
+
+#include <QGeoAddress>
+#include <QGeoCoordinate>
+
+#include <QDateTime>
+#include <QVector>
+#include <QtAlgorithms>
+#include <QtDebug>
+#include <QtEndian>
+
+#include <string.h>
+
+namespace
+{
+
+// Bump when the layout of the log, the index or the serialized places changes. Files of another version are discarded.
+const quint32 FormatVersion = 1;
+
+const char LogMagic[4] = { 'B', 'G', 'S', 'L' };
+const char IndexMagic[4] = { 'B', 'G', 'S', 'I' };
+
+// The log starts with its magic and the format version.
+const qint64 LogHeaderSize = 8;
+
+// Every record starts with the number of bytes that follow the length field, then a CRC-16 (qChecksum()) of the bytes
+// after the checksum field, the length of the key and the expiry, then the key and the serialized places.
+const int RecordLengthSize = 4;
+const int RecordHeaderSize = 16;
+const int RecordChecksumOffset = 4;
+const int RecordKeyLengthOffset = 6;
+const int RecordExpiryOffset = 8;
+
+const quint32 InitialIndexCapacity = 1024;
+
+// The smallest maximum size of the log, so that a tiny maximum does not make every insert ask for a compaction.
+const qint64 MinimumMaxSize = 64 * 1024;
+
+// FNV-1a, so that the index does not depend on the hash function of the Qt version that wrote it.
+quint32 hashKey( const QByteArray & key )
+{
+    quint32 hash = 2166136261u;
+    for ( int i = 0 ; i < key.size() ; i++ ) {
+        hash ^= uchar( key.at(i) );
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void appendVarint( QByteArray * data, quint32 value )
+{
+    while ( value >= 0x80 ) {
+        data->append( char( ( value & 0x7f ) | 0x80 ) );
+        value >>= 7;
+    }
+    data->append( char( value ) );
+}
+
+bool readVarint( const char ** data, const char * end, quint32 * value )
+{
+    *value = 0;
+    for ( int shift = 0 ; shift < 35 ; shift += 7 ) {
+        if ( *data == end ) {
+            return false;
+        }
+        uchar byte = uchar( *(*data)++ );
+        *value |= quint32( byte & 0x7f ) << shift;
+        if ( !( byte & 0x80 ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void appendDouble( QByteArray * data, double value )
+{
+    quint64 bits;
+    memcpy( &bits, &value, sizeof(bits) );
+    uchar buffer[8];
+    qToLittleEndian<quint64>( bits, buffer );
+    data->append( reinterpret_cast<const char *>(buffer), sizeof(buffer) );
+}
+
+bool readDouble( const char ** data, const char * end, double * value )
+{
+    if ( end - *data < 8 ) {
+        return false;
+    }
+    quint64 bits = qFromLittleEndian<quint64>( reinterpret_cast<const uchar *>(*data) );
+    memcpy( value, &bits, sizeof(bits) );
+    *data += 8;
+    return true;
+}
+
+typedef QString ( QtMobilitySubset::QGeoAddress::*AddressGetter )() const;
+typedef void ( QtMobilitySubset::QGeoAddress::*AddressSetter )( const QString & );
+
+// The address fields that are stored, in the order of their bits. These are the fields populatePlaces() fills in.
+struct AddressField
+{
+    AddressGetter get;
+    AddressSetter set;
+};
+
+const AddressField addressFields[] = {
+    { &QtMobilitySubset::QGeoAddress::text, &QtMobilitySubset::QGeoAddress::setText },
+    { &QtMobilitySubset::QGeoAddress::street, &QtMobilitySubset::QGeoAddress::setStreet },
+    { &QtMobilitySubset::QGeoAddress::district, &QtMobilitySubset::QGeoAddress::setDistrict },
+    { &QtMobilitySubset::QGeoAddress::city, &QtMobilitySubset::QGeoAddress::setCity },
+    { &QtMobilitySubset::QGeoAddress::county, &QtMobilitySubset::QGeoAddress::setCounty },
+    { &QtMobilitySubset::QGeoAddress::state, &QtMobilitySubset::QGeoAddress::setState },
+    { &QtMobilitySubset::QGeoAddress::country, &QtMobilitySubset::QGeoAddress::setCountry },
+    { &QtMobilitySubset::QGeoAddress::postcode, &QtMobilitySubset::QGeoAddress::setPostcode },
+    { &QtMobilitySubset::QGeoAddress::countryCode, &QtMobilitySubset::QGeoAddress::setCountryCode }
+};
+
+const int AddressFieldCount = sizeof(addressFields) / sizeof(addressFields[0]);
+
+} // namespace
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+struct GeoSearchStoreBb::IndexHeader
+{
+    char magic[4];
+    quint32 version;
+    quint32 capacity;
+    quint32 count;
+    // the size of the log when the index was last updated
+    qint64 logSize;
+};
+
+// A slot is empty if its offset is 0, which no record can have.
+struct GeoSearchStoreBb::IndexSlot
+{
+    quint32 hash;
+    quint32 length;
+    qint64 offset;
+};
+
+GeoSearchStoreBb::GeoSearchStoreBb( const QString & path, qint64 maxSize )
+    : _path( path ),
+      _maxSize( qMax( maxSize, MinimumMaxSize ) ),
+      _indexMap( NULL ),
+      _hits( 0 )
+{
+    if ( _path.isEmpty() ) {
+        return;
+    }
+
+    if ( !openLog() || !openIndex() ) {
+        qWarning() << "GeoSearchStoreBb: cannot open the store at" << _path;
+        closeIndex();
+        _log.close();
+    }
+}
+
+GeoSearchStoreBb::~GeoSearchStoreBb()
+{
+    closeIndex();
+}
+
+bool GeoSearchStoreBb::isOpen() const
+{
+    return _indexMap && _log.isOpen();
+}
+
+bool GeoSearchStoreBb::find( const QByteArray & key, QList<QtMobilitySubset::QGeoPlace> * places, qint64 * expiry )
+{
+    if ( !isOpen() ) {
+        return false;
+    }
+
+    quint32 hash = hashKey( key );
+    quint32 mask = indexHeader()->capacity - 1;
+    for ( quint32 i = hash & mask ; indexSlots()[i].offset != 0 ; i = ( i + 1 ) & mask ) {
+        if ( indexSlots()[i].hash != hash ) {
+            continue;
+        }
+
+        QByteArray recordKey;
+        QByteArray payload;
+        qint64 recordExpiry;
+        if ( !readRecord( indexSlots()[i].offset, &recordKey, &payload, &recordExpiry, NULL ) || recordKey != key ) {
+            continue;
+        }
+
+        if ( recordExpiry != 0 && recordExpiry <= QDateTime::currentMSecsSinceEpoch() ) {
+            return false;
+        }
+        if ( !deserializePlaces( payload.constData(), payload.size(), places ) ) {
+            return false;
+        }
+
+        *expiry = recordExpiry;
+        _hits++;
+        return true;
+    }
+
+    return false;
+}
+
+void GeoSearchStoreBb::insert( const QByteArray & key, const QList<QtMobilitySubset::QGeoPlace> & places, qint64 expiry )
+{
+    if ( !isOpen() || key.size() > 0xffff ) {
+        return;
+    }
+
+    // the log waits for the engine to compact it, but does not grow without bound in the meantime.
+    if ( _log.size() > 2 * _maxSize ) {
+        return;
+    }
+
+    QByteArray payload = serializePlaces( places );
+
+    QByteArray record( RecordHeaderSize, '\0' );
+    record.append( key );
+    record.append( payload );
+
+    uchar * data = reinterpret_cast<uchar *>( record.data() );
+    qToLittleEndian<quint32>( record.size() - RecordLengthSize, data );
+    qToLittleEndian<quint16>( key.size(), data + RecordKeyLengthOffset );
+    qToLittleEndian<qint64>( expiry, data + RecordExpiryOffset );
+    quint16 checksum = qChecksum( record.constData() + RecordKeyLengthOffset, record.size() - RecordKeyLengthOffset );
+    qToLittleEndian<quint16>( checksum, data + RecordChecksumOffset );
+
+    qint64 offset = _log.size();
+    if ( !_log.seek( offset ) || _log.write( record ) != record.size() || !_log.flush() ) {
+        qWarning() << "GeoSearchStoreBb: cannot write to" << _log.fileName();
+        _log.resize( offset );
+        return;
+    }
+
+    if ( !addToIndex( key, hashKey( key ), offset, record.size() ) ) {
+        return;
+    }
+    indexHeader()->logSize = offset + record.size();
+}
+
+bool GeoSearchStoreBb::needsCompaction() const
+{
+    return isOpen() && _log.size() > _maxSize;
+}
+
+void GeoSearchStoreBb::compact()
+{
+    if ( !isOpen() ) {
+        return;
+    }
+
+    // the newest records of all keys, oldest first
+    QVector<IndexSlot> live;
+    live.reserve( indexHeader()->count );
+    for ( quint32 i = 0 ; i < indexHeader()->capacity ; i++ ) {
+        if ( indexSlots()[i].offset != 0 ) {
+            live.append( indexSlots()[i] );
+        }
+    }
+    qSort( live.begin(), live.end(), offsetLessThan );
+
+    // drop the expired records, then the oldest ones until the rest fit in half the maximum size.
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 liveSize = 0;
+    QVector<IndexSlot> kept;
+    kept.reserve( live.size() );
+    for ( int i = 0 ; i < live.size() ; i++ ) {
+        uchar expiryData[8];
+        if ( !_log.seek( live.at(i).offset + RecordExpiryOffset )
+                || _log.read( reinterpret_cast<char *>(expiryData), sizeof(expiryData) ) != qint64( sizeof(expiryData) ) ) {
+            continue;
+        }
+        qint64 expiry = qFromLittleEndian<qint64>( expiryData );
+        if ( expiry != 0 && expiry <= now ) {
+            continue;
+        }
+        kept.append( live.at(i) );
+        liveSize += live.at(i).length;
+    }
+
+    int first = 0;
+    while ( first < kept.size() && LogHeaderSize + liveSize > _maxSize / 2 ) {
+        liveSize -= kept.at(first).length;
+        first++;
+    }
+
+    QFile compacted( _path + ".log.new" );
+    bool ok = compacted.open( QIODevice::WriteOnly | QIODevice::Truncate );
+    if ( ok ) {
+        QByteArray logHeader( LogMagic, sizeof(LogMagic) );
+        logHeader.resize( LogHeaderSize );
+        qToLittleEndian<quint32>( FormatVersion, reinterpret_cast<uchar *>( logHeader.data() ) + sizeof(LogMagic) );
+        ok = compacted.write( logHeader ) == logHeader.size();
+    }
+    for ( int i = first ; ok && i < kept.size() ; i++ ) {
+        ok = _log.seek( kept.at(i).offset );
+        QByteArray record = _log.read( kept.at(i).length );
+        ok = ok && record.size() == int( kept.at(i).length ) && compacted.write( record ) == record.size();
+    }
+    ok = ok && compacted.flush();
+    compacted.close();
+
+    if ( !ok ) {
+        qWarning() << "GeoSearchStoreBb: cannot compact" << _log.fileName();
+        compacted.remove();
+        return;
+    }
+
+    closeIndex();
+    QString logName = _log.fileName();
+    _log.close();
+    if ( !QFile::remove( logName ) || !compacted.rename( logName ) || !openLog() ) {
+        qWarning() << "GeoSearchStoreBb: cannot replace" << logName << "with its compacted copy";
+        _log.close();
+        return;
+    }
+
+    quint32 capacity = InitialIndexCapacity;
+    while ( capacity < quint32( kept.size() - first ) * 2 ) {
+        capacity *= 2;
+    }
+    if ( !rebuildIndex( capacity ) ) {
+        closeIndex();
+        _log.close();
+    }
+}
+
+int GeoSearchStoreBb::count() const
+{
+    return isOpen() ? int( indexHeader()->count ) : 0;
+}
+
+qint64 GeoSearchStoreBb::size() const
+{
+    return isOpen() ? _log.size() : 0;
+}
+
+quint64 GeoSearchStoreBb::hits() const
+{
+    return _hits;
+}
+
+QByteArray GeoSearchStoreBb::serializePlaces( const QList<QtMobilitySubset::QGeoPlace> & places )
+{
+    QByteArray data;
+    appendVarint( &data, places.size() );
+
+    for ( int i = 0 ; i < places.size() ; i++ ) {
+        QtMobilitySubset::QGeoCoordinate coordinate = places.at(i).coordinate();
+        appendDouble( &data, coordinate.latitude() );
+        appendDouble( &data, coordinate.longitude() );
+
+        QtMobilitySubset::QGeoAddress address = places.at(i).address();
+        QList<QByteArray> values;
+        quint32 fields = 0;
+        for ( int field = 0 ; field < AddressFieldCount ; field++ ) {
+            // a generated text is generated again from the other fields when the place is read back.
+            if ( field == 0 && address.isTextGenerated() ) {
+                continue;
+            }
+            QString value = ( address.*addressFields[field].get )();
+            if ( !value.isEmpty() ) {
+                fields |= 1u << field;
+                values.append( value.toUtf8() );
+            }
+        }
+
+        appendVarint( &data, fields );
+        for ( int j = 0 ; j < values.size() ; j++ ) {
+            appendVarint( &data, values.at(j).size() );
+            data.append( values.at(j) );
+        }
+    }
+
+    return data;
+}
+
+bool GeoSearchStoreBb::deserializePlaces( const char * data, int size, QList<QtMobilitySubset::QGeoPlace> * places )
+{
+    const char * end = data + size;
+
+    quint32 count;
+    if ( !readVarint( &data, end, &count ) ) {
+        return false;
+    }
+
+    QList<QtMobilitySubset::QGeoPlace> result;
+    for ( quint32 i = 0 ; i < count ; i++ ) {
+        double latitude;
+        double longitude;
+        if ( !readDouble( &data, end, &latitude ) || !readDouble( &data, end, &longitude ) ) {
+            return false;
+        }
+
+        // populatePlaces() leaves the latitude or longitude unset if georeg does not have it.
+        QtMobilitySubset::QGeoCoordinate coordinate;
+        if ( !qIsNaN( latitude ) ) {
+            coordinate.setLatitude( latitude );
+        }
+        if ( !qIsNaN( longitude ) ) {
+            coordinate.setLongitude( longitude );
+        }
+
+        quint32 fields;
+        if ( !readVarint( &data, end, &fields ) ) {
+            return false;
+        }
+
+        QtMobilitySubset::QGeoAddress address;
+        for ( int field = 0 ; field < AddressFieldCount ; field++ ) {
+            if ( !( fields & ( 1u << field ) ) ) {
+                continue;
+            }
+            quint32 length;
+            if ( !readVarint( &data, end, &length ) || length > quint32( end - data ) ) {
+                return false;
+            }
+            ( address.*addressFields[field].set )( QString::fromUtf8( data, length ) );
+            data += length;
+        }
+
+        QtMobilitySubset::QGeoPlace place;
+        place.setCoordinate( coordinate );
+        place.setAddress( address );
+        result.append( place );
+    }
+
+    if ( data != end ) {
+        return false;
+    }
+
+    *places = result;
+    return true;
+}
+
+// Opens the log, replacing it if it was written by another version.
+bool GeoSearchStoreBb::openLog()
+{
+    _log.setFileName( _path + ".log" );
+    if ( !_log.open( QIODevice::ReadWrite ) ) {
+        return false;
+    }
+
+    if ( _log.size() >= LogHeaderSize ) {
+        uchar logHeader[LogHeaderSize];
+        if ( _log.read( reinterpret_cast<char *>(logHeader), LogHeaderSize ) == LogHeaderSize
+                && memcmp( logHeader, LogMagic, sizeof(LogMagic) ) == 0
+                && qFromLittleEndian<quint32>( logHeader + sizeof(LogMagic) ) == FormatVersion ) {
+            return true;
+        }
+        qWarning() << "GeoSearchStoreBb: discarding" << _log.fileName() << "written by another version";
+    }
+
+    uchar logHeader[LogHeaderSize];
+    memcpy( logHeader, LogMagic, sizeof(LogMagic) );
+    qToLittleEndian<quint32>( FormatVersion, logHeader + sizeof(LogMagic) );
+    return _log.resize( 0 )
+           && _log.seek( 0 )
+           && _log.write( reinterpret_cast<const char *>(logHeader), LogHeaderSize ) == LogHeaderSize
+           && _log.flush();
+}
+
+// Maps the index if it matches the log, and rebuilds it from the log otherwise.
+bool GeoSearchStoreBb::openIndex()
+{
+    _index.setFileName( _path + ".idx" );
+    if ( !_index.open( QIODevice::ReadWrite ) ) {
+        return false;
+    }
+
+    IndexHeader stored;
+    if ( _index.size() >= qint64( sizeof(stored) )
+            && _index.read( reinterpret_cast<char *>(&stored), sizeof(stored) ) == qint64( sizeof(stored) )
+            && memcmp( stored.magic, IndexMagic, sizeof(IndexMagic) ) == 0
+            && stored.version == FormatVersion
+            && stored.capacity >= InitialIndexCapacity
+            && ( stored.capacity & ( stored.capacity - 1 ) ) == 0
+            && _index.size() == qint64( sizeof(IndexHeader) + stored.capacity * sizeof(IndexSlot) )
+            && stored.logSize >= LogHeaderSize
+            && stored.logSize <= _log.size()
+            && mapIndex( stored.capacity ) ) {
+        // index the records appended after the index was last updated, if the application stopped in between.
+        return indexLog( indexHeader()->logSize );
+    }
+
+    return rebuildIndex( InitialIndexCapacity );
+}
+
+// Resizes the index file to capacity slots and maps it.
+bool GeoSearchStoreBb::mapIndex( quint32 capacity )
+{
+    closeIndex();
+
+    qint64 indexSize = sizeof(IndexHeader) + qint64( capacity ) * sizeof(IndexSlot);
+    if ( _index.size() != indexSize && !_index.resize( indexSize ) ) {
+        return false;
+    }
+
+    _indexMap = _index.map( 0, indexSize );
+    return _indexMap != NULL;
+}
+
+void GeoSearchStoreBb::closeIndex()
+{
+    if ( _indexMap ) {
+        _index.unmap( _indexMap );
+        _indexMap = NULL;
+    }
+}
+
+// Empties the index, resized to capacity slots, and indexes the whole log.
+bool GeoSearchStoreBb::rebuildIndex( quint32 capacity )
+{
+    if ( !mapIndex( capacity ) ) {
+        return false;
+    }
+
+    memset( _indexMap, 0, sizeof(IndexHeader) + capacity * sizeof(IndexSlot) );
+    memcpy( indexHeader()->magic, IndexMagic, sizeof(IndexMagic) );
+    indexHeader()->version = FormatVersion;
+    indexHeader()->capacity = capacity;
+    indexHeader()->count = 0;
+    indexHeader()->logSize = LogHeaderSize;
+
+    return indexLog( LogHeaderSize );
+}
+
+// Adds the records from offset from to the end of the log to the index. A record that is cut short or does not
+// match its checksum was being written when the application stopped, and is truncated with everything after it.
+bool GeoSearchStoreBb::indexLog( qint64 from )
+{
+    qint64 offset = from;
+    while ( offset < _log.size() ) {
+        QByteArray key;
+        quint32 length;
+        if ( !readRecord( offset, &key, NULL, NULL, &length ) ) {
+            qWarning() << "GeoSearchStoreBb: truncating" << _log.fileName() << "at a damaged record";
+            if ( !_log.resize( offset ) ) {
+                return false;
+            }
+            break;
+        }
+
+        if ( !addToIndex( key, hashKey( key ), offset, length ) ) {
+            return false;
+        }
+        offset += length;
+    }
+
+    indexHeader()->logSize = offset;
+    return isOpen();
+}
+
+// Points the index entry of key at the record at offset, growing the index if it gets too full. Closes the store
+// and returns false if the index cannot grow.
+bool GeoSearchStoreBb::addToIndex( const QByteArray & key, quint32 hash, qint64 offset, quint32 length )
+{
+    if ( ( indexHeader()->count + 1 ) * 4 > indexHeader()->capacity * 3 ) {
+        QVector<IndexSlot> entries;
+        entries.reserve( indexHeader()->count );
+        for ( quint32 i = 0 ; i < indexHeader()->capacity ; i++ ) {
+            if ( indexSlots()[i].offset != 0 ) {
+                entries.append( indexSlots()[i] );
+            }
+        }
+
+        IndexHeader grown = *indexHeader();
+        if ( !mapIndex( grown.capacity * 2 ) ) {
+            qWarning() << "GeoSearchStoreBb: cannot grow" << _index.fileName();
+            _log.close();
+            return false;
+        }
+
+        *indexHeader() = grown;
+        indexHeader()->capacity *= 2;
+        memset( indexSlots(), 0, indexHeader()->capacity * sizeof(IndexSlot) );
+
+        // the keys of the entries are all different, so they only need an empty slot.
+        quint32 mask = indexHeader()->capacity - 1;
+        for ( int j = 0 ; j < entries.size() ; j++ ) {
+            quint32 i = entries.at(j).hash & mask;
+            while ( indexSlots()[i].offset != 0 ) {
+                i = ( i + 1 ) & mask;
+            }
+            indexSlots()[i] = entries.at(j);
+        }
+    }
+
+    quint32 mask = indexHeader()->capacity - 1;
+    quint32 i = hash & mask;
+    for ( ; indexSlots()[i].offset != 0 ; i = ( i + 1 ) & mask ) {
+        QByteArray slotKey;
+        if ( indexSlots()[i].hash == hash && readRecord( indexSlots()[i].offset, &slotKey, NULL, NULL, NULL ) && slotKey == key ) {
+            // a newer record for the key replaces the older one.
+            indexSlots()[i].length = length;
+            indexSlots()[i].offset = offset;
+            return true;
+        }
+    }
+
+    indexSlots()[i].hash = hash;
+    indexSlots()[i].length = length;
+    indexSlots()[i].offset = offset;
+    indexHeader()->count++;
+    return true;
+}
+
+// Reads the record at offset, checking that it is complete and matches its checksum.
+bool GeoSearchStoreBb::readRecord( qint64 offset, QByteArray * key, QByteArray * payload, qint64 * expiry, quint32 * length )
+{
+    uchar lengthData[RecordLengthSize];
+    if ( offset + RecordHeaderSize > _log.size()
+            || !_log.seek( offset )
+            || _log.read( reinterpret_cast<char *>(lengthData), RecordLengthSize ) != RecordLengthSize ) {
+        return false;
+    }
+
+    quint32 recordLength = qFromLittleEndian<quint32>( lengthData );
+    if ( recordLength < quint32( RecordHeaderSize - RecordLengthSize )
+            || offset + RecordLengthSize + recordLength > _log.size() ) {
+        return false;
+    }
+
+    QByteArray record = _log.read( recordLength );
+    if ( record.size() != int( recordLength ) ) {
+        return false;
+    }
+
+    // the offsets in the record data are RecordLengthSize smaller than in the whole record.
+    const uchar * data = reinterpret_cast<const uchar *>( record.constData() );
+    const int checked = RecordKeyLengthOffset - RecordLengthSize;
+    quint16 checksum = qFromLittleEndian<quint16>( data + RecordChecksumOffset - RecordLengthSize );
+    if ( checksum != qChecksum( record.constData() + checked, recordLength - checked ) ) {
+        return false;
+    }
+
+    int keyStart = RecordHeaderSize - RecordLengthSize;
+    int keyLength = qFromLittleEndian<quint16>( data + RecordKeyLengthOffset - RecordLengthSize );
+    if ( keyStart + keyLength > record.size() ) {
+        return false;
+    }
+
+    *key = record.mid( keyStart, keyLength );
+    if ( payload ) {
+        *payload = record.mid( keyStart + keyLength );
+    }
+    if ( expiry ) {
+        *expiry = qFromLittleEndian<qint64>( data + RecordExpiryOffset - RecordLengthSize );
+    }
+    if ( length ) {
+        *length = RecordLengthSize + recordLength;
+    }
+    return true;
+}
+
+GeoSearchStoreBb::IndexSlot * GeoSearchStoreBb::indexSlots() const
+{
+    return reinterpret_cast<IndexSlot *>( _indexMap + sizeof(IndexHeader) );
+}
+
+GeoSearchStoreBb::IndexHeader * GeoSearchStoreBb::indexHeader() const
+{
+    return reinterpret_cast<IndexHeader *>( _indexMap );
+}
+
+bool GeoSearchStoreBb::offsetLessThan( const IndexSlot & left, const IndexSlot & right )
+{
+    return left.offset < right.offset;
+}
+
+} // namespace
+} // namespace
+} // namespace
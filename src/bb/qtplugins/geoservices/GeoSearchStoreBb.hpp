@@ -0,0 +1,121 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHSTOREBB_HPP
+#define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHSTOREBB_HPP
+
+#include <QGeoPlace>
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+/**
+ * A store of georeg results on disk, which keeps them across restarts of the application.
+ *
+ * The results are kept in two files. The log, path + ".log", holds the records in the order they were inserted;
+ * a record is never changed once written, and a newer record for a key replaces the older ones. The index,
+ * path + ".idx", is a hash table from keys to the offsets of their newest records, which is memory mapped so
+ * that a lookup only reads the record it finds from the log. The index can always be rebuilt from the log, and
+ * is, when it is missing, was written by another version or does not cover the whole log.
+ *
+ * Every record carries a CRC-16 (qChecksum()) of its contents, so that a record that was torn when the application
+ * stopped is detected.
+ *
+ * When the log grows beyond its maximum size it needs to be compacted, which the owner of the store does with
+ * compact() when it suits it rather than on the insert that crossed the size: the newest record of every key that
+ * has not expired is copied to a new log, oldest first, and if that is still too large the oldest records are
+ * dropped until it uses half the maximum size. Inserts are dropped while the log is over twice the maximum size.
+ *
+ * The store is not thread safe; it is only used from the thread of the engine that owns it.
+ */
+class GeoSearchStoreBb
+{
+public:
+    /**
+     * Opens the store at path, creating it if necessary.
+     *
+     * @param path The path of the store's files, without their extensions.
+     * @param maxSize The size in bytes the log needs to be compacted at, at least 64 KB.
+     */
+    GeoSearchStoreBb( const QString & path, qint64 maxSize );
+    ~GeoSearchStoreBb();
+
+    bool isOpen() const;
+
+    /**
+     * Looks up the places stored for a key.
+     *
+     * @param key The key of the request.
+     * @param places Set to the stored places if there is a record for the key that has not expired.
+     * @param expiry Set to the time the record expires, in milliseconds since the epoch, or 0 if it does not.
+     *
+     * @return true if a record was found.
+     */
+    bool find( const QByteArray & key, QList<QtMobilitySubset::QGeoPlace> * places, qint64 * expiry );
+
+    /**
+     * Appends a record for a key to the log.
+     *
+     * @param expiry The time the record expires, in milliseconds since the epoch, or 0 if it does not.
+     */
+    void insert( const QByteArray & key, const QList<QtMobilitySubset::QGeoPlace> & places, qint64 expiry );
+
+    // whether the log has grown beyond its maximum size
+    bool needsCompaction() const;
+    void compact();
+
+    int count() const;
+    qint64 size() const;
+    quint64 hits() const;
+
+    /**
+     * Writes places in the compact binary form used by the store: a count, then for each place its latitude and
+     * longitude followed by a bit for each address field that is set and the UTF-8 text of those fields.
+     */
+    static QByteArray serializePlaces( const QList<QtMobilitySubset::QGeoPlace> & places );
+    static bool deserializePlaces( const char * data, int size, QList<QtMobilitySubset::QGeoPlace> * places );
+
+private:
+    Q_DISABLE_COPY(GeoSearchStoreBb)
+
+    struct IndexHeader;
+    struct IndexSlot;
+
+    bool openLog();
+    bool openIndex();
+    bool mapIndex( quint32 capacity );
+    void closeIndex();
+    bool rebuildIndex( quint32 capacity );
+    bool indexLog( qint64 from );
+    bool addToIndex( const QByteArray & key, quint32 hash, qint64 offset, quint32 length );
+    bool readRecord( qint64 offset, QByteArray * key, QByteArray * payload, qint64 * expiry, quint32 * length );
+    IndexSlot * indexSlots() const;
+    IndexHeader * indexHeader() const;
+
+    static bool offsetLessThan( const IndexSlot & left, const IndexSlot & right );
+
+    QString _path;
+    qint64 _maxSize;
+    QFile _log;
+    QFile _index;
+    uchar * _indexMap;
+    quint64 _hits;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
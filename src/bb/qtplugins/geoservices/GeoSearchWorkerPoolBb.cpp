@@ -0,0 +1,360 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#include "GeoSearchWorkerPoolBb.hpp"
+#include "GeoSearchReplyBb.hpp"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFutureInterface>
+#include <QMutexLocker>
+#include <QRunnable>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+// A queued request or chunk of a batch, which reports the replies to the future of the request or batch.
+class GeoSearchWorkerPoolBb::Task
+{
+public:
+    QFutureInterface<GeoregReply> future;
+    QList<GeoregRequest> requests;
+    // the index in the future of the reply to the first request
+    int first;
+    QByteArray key;
+    int priority;
+    // the number of requests waiting for the reply; the task is canceled when all of them are
+    int subscribers;
+    // the number of chunks of the batch that have not finished, shared by the chunks; null for a single request
+    QSharedPointer<QAtomicInt> unfinished;
+    QElapsedTimer queued;
+};
+
+// Runs the queued tasks until the queue is empty. At most size() workers run at the same time.
+class GeoSearchWorkerPoolBb::Worker : public QRunnable
+{
+public:
+    explicit Worker( GeoSearchWorkerPoolBb * pool )
+        : _pool( pool )
+    {
+    }
+
+    virtual void run()
+    {
+        _pool->work();
+    }
+
+private:
+    GeoSearchWorkerPoolBb * _pool;
+};
+
+GeoSearchWorkerPoolBb::GeoSearchWorkerPoolBb( int size, int placesChunkSize, const QSharedPointer<GeoSearchHandlePoolBb> & handlePool )
+    : _queueDepth( 0 ),
+      _running( 0 ),
+      _size( qMax( size, 1 ) ),
+      _placesChunkSize( placesChunkSize ),
+      _handlePool( handlePool ),
+      _dequeued( 0 ),
+      _totalWaitTime( 0 ),
+      _maximumWaitTime( 0 ),
+      _sharedRequests( 0 ),
+      _canceledQueuedRequests( 0 ),
+      _canceledRunningRequests( 0 ),
+      _canceledPlaces( 0 )
+{
+    _threads.setMaxThreadCount( _size );
+}
+
+GeoSearchWorkerPoolBb::~GeoSearchWorkerPoolBb()
+{
+    QMutexLocker locker( &_mutex );
+
+    QList<Task *> queued;
+    for ( QMap<int, QQueue<Task *> >::iterator it = _queue.begin() ; it != _queue.end() ; ++it ) {
+        queued += it.value();
+    }
+    _queue.clear();
+    _queueDepth = 0;
+
+    // the tasks left in flight are running; they stop at the next place.
+    for ( QHash<QByteArray, Task *>::const_iterator it = _inFlight.constBegin() ; it != _inFlight.constEnd() ; ++it ) {
+        it.value()->future.cancel();
+    }
+    _inFlight.clear();
+
+    for ( int i = 0 ; i < queued.size() ; i++ ) {
+        finishTask( queued.at(i) );
+    }
+
+    locker.unlock();
+
+    // the workers use this pool until they find the queue empty.
+    _threads.waitForDone();
+}
+
+QFuture<GeoregReply> GeoSearchWorkerPoolBb::submit( const GeoregRequest & request, Priority priority, bool * shared )
+{
+    QByteArray key = requestKey( request );
+
+    QMutexLocker locker( &_mutex );
+    Task * task = _inFlight.value( key );
+    if ( shared ) {
+        *shared = ( task != 0 );
+    }
+    if ( task ) {
+        // an interactive request does not wait behind the background requests for a task it shares.
+        QMap<int, QQueue<Task *> >::iterator queued = _queue.find( task->priority );
+        if ( priority > task->priority && queued != _queue.end() && queued.value().removeOne( task ) ) {
+            if ( queued.value().isEmpty() ) {
+                _queue.erase( queued );
+            }
+            task->priority = priority;
+            _queue[priority].enqueue( task );
+        }
+        task->subscribers++;
+        _sharedRequests++;
+        return task->future.future();
+    }
+
+    task = new Task;
+    task->requests.append( request );
+    task->first = 0;
+    task->key = key;
+    task->priority = priority;
+    task->subscribers = 1;
+    task->future.reportStarted();
+    task->queued.start();
+
+    _inFlight.insert( key, task );
+    _queue[priority].enqueue( task );
+    _queueDepth++;
+    startWorkers( 1 );
+
+    return task->future.future();
+}
+
+QFuture<GeoregReply> GeoSearchWorkerPoolBb::submitBatch( const QList<GeoregRequest> & requests, int chunkSize, Priority priority )
+{
+    QFutureInterface<GeoregReply> future;
+    future.reportStarted();
+    if ( requests.isEmpty() ) {
+        future.reportFinished();
+        return future.future();
+    }
+
+    chunkSize = qMax( chunkSize, 1 );
+    int chunks = ( requests.size() + chunkSize - 1 ) / chunkSize;
+    QSharedPointer<QAtomicInt> unfinished( new QAtomicInt( chunks ) );
+
+    QMutexLocker locker( &_mutex );
+    for ( int first = 0 ; first < requests.size() ; first += chunkSize ) {
+        Task * task = new Task;
+        task->future = future;
+        task->requests = requests.mid( first, chunkSize );
+        task->first = first;
+        // a key no single request has, so that the chunk can be found by cancel() but is never shared
+        task->key = "b" + QByteArray::number( qulonglong( quintptr( task ) ), 16 );
+        task->priority = priority;
+        task->subscribers = 1;
+        task->unfinished = unfinished;
+        task->queued.start();
+
+        _inFlight.insert( task->key, task );
+        _queue[priority].enqueue( task );
+        _queueDepth++;
+    }
+    startWorkers( chunks );
+
+    return future.future();
+}
+
+void GeoSearchWorkerPoolBb::cancel( const QFuture<GeoregReply> & future )
+{
+    QMutexLocker locker( &_mutex );
+
+    // the request, or the chunks of the batch, that have not finished
+    QList<Task *> tasks;
+    for ( QHash<QByteArray, Task *>::const_iterator it = _inFlight.constBegin() ; it != _inFlight.constEnd() ; ++it ) {
+        if ( it.value()->future.future() == future ) {
+            tasks.append( it.value() );
+        }
+    }
+
+    // the request has finished already, or other requests still wait for its reply.
+    if ( tasks.isEmpty() || --tasks.first()->subscribers > 0 ) {
+        return;
+    }
+
+    tasks.first()->future.cancel();
+
+    for ( int i = 0 ; i < tasks.size() ; i++ ) {
+        Task * task = tasks.at(i);
+        _inFlight.remove( task->key );
+
+        QMap<int, QQueue<Task *> >::iterator queued = _queue.find( task->priority );
+        if ( queued != _queue.end() && queued.value().removeOne( task ) ) {
+            if ( queued.value().isEmpty() ) {
+                _queue.erase( queued );
+            }
+            _queueDepth--;
+            _canceledQueuedRequests += task->requests.size();
+            finishTask( task );
+        } else {
+            // the worker running the task stops reading places and finishes it.
+            _canceledRunningRequests++;
+        }
+    }
+}
+
+int GeoSearchWorkerPoolBb::size() const
+{
+    return _size;
+}
+
+int GeoSearchWorkerPoolBb::queueDepth() const
+{
+    QMutexLocker locker( &_mutex );
+    return _queueDepth;
+}
+
+double GeoSearchWorkerPoolBb::averageWaitTime() const
+{
+    QMutexLocker locker( &_mutex );
+    return _dequeued ? _totalWaitTime / 1000000.0 / _dequeued : 0.0;
+}
+
+double GeoSearchWorkerPoolBb::maximumWaitTime() const
+{
+    QMutexLocker locker( &_mutex );
+    return _maximumWaitTime / 1000000.0;
+}
+
+quint64 GeoSearchWorkerPoolBb::sharedRequests() const
+{
+    QMutexLocker locker( &_mutex );
+    return _sharedRequests;
+}
+
+quint64 GeoSearchWorkerPoolBb::canceledQueuedRequests() const
+{
+    QMutexLocker locker( &_mutex );
+    return _canceledQueuedRequests;
+}
+
+quint64 GeoSearchWorkerPoolBb::canceledRunningRequests() const
+{
+    QMutexLocker locker( &_mutex );
+    return _canceledRunningRequests;
+}
+
+quint64 GeoSearchWorkerPoolBb::canceledPlaces() const
+{
+    QMutexLocker locker( &_mutex );
+    return _canceledPlaces;
+}
+
+QByteArray GeoSearchWorkerPoolBb::requestKey( const GeoregRequest & request )
+{
+    double latitude = request.coordinate.latitude();
+    double longitude = request.coordinate.longitude();
+
+    QByteArray key;
+    key.append( request.reverse ? 'r' : 'g' );
+    key.append( char( request.boundary ) );
+    key.append( reinterpret_cast<const char *>( &latitude ), sizeof( latitude ) );
+    key.append( reinterpret_cast<const char *>( &longitude ), sizeof( longitude ) );
+    key.append( request.locale.toUtf8() );
+    key.append( '|' );
+    // the query is matched without regard to case, as the georeg service does.
+    key.append( QString::fromUtf8( request.searchString ).toCaseFolded().toUtf8() );
+    return key;
+}
+
+// Starts workers for tasks that were queued, as far as the size of the pool allows. Called with the mutex locked.
+void GeoSearchWorkerPoolBb::startWorkers( int tasks )
+{
+    for ( int i = 0 ; i < tasks && _running < _size ; i++ ) {
+        _running++;
+        _threads.start( new Worker( this ) );
+    }
+}
+
+// Finishes the future of task, once all the chunks of a batch are done, and deletes task. Called with the mutex
+// locked.
+void GeoSearchWorkerPoolBb::finishTask( Task * task )
+{
+    if ( !task->unfinished || !task->unfinished->deref() ) {
+        task->future.reportFinished();
+    }
+    delete task;
+}
+
+void GeoSearchWorkerPoolBb::work()
+{
+    forever {
+        Task * task;
+        {
+            QMutexLocker locker( &_mutex );
+            if ( _queueDepth == 0 ) {
+                _running--;
+                return;
+            }
+
+            // the queue of the highest priority that has tasks
+            QMap<int, QQueue<Task *> >::iterator it = _queue.end() - 1;
+            task = it.value().dequeue();
+            if ( it.value().isEmpty() ) {
+                _queue.erase( it );
+            }
+            _queueDepth--;
+
+            qint64 waitTime = task->queued.nsecsElapsed();
+            _dequeued++;
+            _totalWaitTime += waitTime;
+            _maximumWaitTime = qMax( _maximumWaitTime, waitTime );
+        }
+
+        int skippedRequests = 0;
+        int skippedPlaces = 0;
+        for ( int i = 0 ; i < task->requests.size() ; i++ ) {
+            if ( task->future.isCanceled() ) {
+                skippedRequests = task->requests.size() - i;
+                break;
+            }
+
+            // the reply to a single request is reported in parts, the last of which follows the ones runRequest()
+            // reports; the reply to each request of a batch is reported at once, at the index of the request.
+            int skipped = 0;
+            bool single = !task->unfinished;
+            GeoregReply georegReply = GeoSearchReplyBb::runRequest( task->requests.at(i), _handlePool, &task->future, &skipped,
+                                                                    single ? _placesChunkSize : 0 );
+            skippedPlaces += skipped;
+
+            // nobody waits for the reply of a canceled task.
+            if ( !task->future.isCanceled() ) {
+                task->future.reportResult( georegReply, single ? -1 : task->first + i );
+            }
+        }
+
+        // later requests start a call of their own, rather than share a reply that may be outdated. A canceled
+        // task has been removed already, and another task may have taken its key since.
+        QMutexLocker locker( &_mutex );
+        if ( _inFlight.value( task->key ) == task ) {
+            _inFlight.remove( task->key );
+        }
+        _canceledQueuedRequests += skippedRequests;
+        _canceledPlaces += skippedPlaces;
+        finishTask( task );
+    }
+}
+
+} // namespace
+} // namespace
+} // namespace
@@ -0,0 +1,184 @@
+/**
+ * @copyright
+ * Copyright Research In Motion Limited, 2012-2012
+ * Research In Motion Limited. All rights reserved.
+ */
+
+#ifndef BB_QTPLUGINS_GEOSERVICES_GEOSEARCHWORKERPOOLBB_HPP
+#define BB_QTPLUGINS_GEOSERVICES_GEOSEARCHWORKERPOOLBB_HPP
+
+#include "GeoSearchHandlePoolBb.hpp"
+#include "private/bbmock/GeoregApi.hpp"
+
+#include <QGeoCoordinate>
+#include <QGeoPlace>
+#include <QGeoSearchReply>
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QString>
+#include <QThreadPool>
+
+namespace bb
+{
+namespace qtplugins
+{
+namespace geoservices
+{
+
+typedef struct GeoregReplyStruct
+{
+    QtMobilitySubset::QGeoSearchReply::Error error;
+    QList<QtMobilitySubset::QGeoPlace> places;
+
+} GeoregReply;
+
+typedef struct GeoregRequestStruct
+{
+    // true for a reverse geocode request, false for a geocode request
+    bool reverse;
+    // the text to geocode
+    QByteArray searchString;
+    // the coordinate to reverse geocode, or the optional hint where to geocode
+    QtMobilitySubset::QGeoCoordinate coordinate;
+    // the kind of place to reverse geocode to
+    geo_search_boundary_t boundary;
+    // the name of the locale the places are for. georeg does not take it, but requests for different locales
+    // are not shared.
+    QString locale;
+
+} GeoregRequest;
+
+/**
+ * The threads an engine sends its georeg requests from, so that the blocking georeg calls neither wait for nor
+ * hold up the other users of QThreadPool::globalInstance().
+ *
+ * At most size() requests run at the same time. The others wait in a queue, interactive requests ahead of
+ * background ones and otherwise in the order they were submitted.
+ *
+ * A request that is the same as one that is queued or running is not sent again but shares the future of the
+ * first one, so that many replies asking for the same place at once cost one georeg call.
+ *
+ * A batch of requests is split into chunks, which are queued like single requests, so that several workers send
+ * the requests of a batch at the same time while a batch does not keep a worker from other requests for long.
+ *
+ * The places of the reply to a single request are reported in parts as they are read, so that the first of many
+ * places can be shown before the last is read. The future then receives a reply for each part, in order; the last
+ * one carries the error of the request.
+ *
+ * A request that nobody waits for any more is canceled: it is taken out of the queue, or, if it is running, it
+ * stops reading the places of its reply and its future never receives a result.
+ *
+ * The pool is thread safe.
+ */
+class GeoSearchWorkerPoolBb
+{
+public:
+    enum Priority
+    {
+        BackgroundPriority,
+        InteractivePriority
+    };
+
+    /**
+     * Creates a pool.
+     *
+     * @param size The maximum number of requests that run at the same time.
+     * @param placesChunkSize The number of places of a reply that are reported together, or 0 to report all of
+     * them at once.
+     * @param handlePool The pool of georeg handles the requests are sent on.
+     */
+    GeoSearchWorkerPoolBb( int size, int placesChunkSize, const QSharedPointer<GeoSearchHandlePoolBb> & handlePool );
+
+    /**
+     * Cancels the queued requests and waits for the running ones to finish.
+     */
+    ~GeoSearchWorkerPoolBb();
+
+    /**
+     * Queues request, unless the same request is already queued or running.
+     *
+     * @param shared Set to whether the future is shared with an earlier request.
+     *
+     * @return A future that receives the reply of the georeg service, in parts of up to placesChunkSize places.
+     */
+    QFuture<GeoregReply> submit( const GeoregRequest & request, Priority priority, bool * shared = 0 );
+
+    /**
+     * Withdraws one of the requests that received future from submit(). The request is canceled when all the
+     * requests that share it have been withdrawn; a canceled future is finished without a result.
+     */
+    void cancel( const QFuture<GeoregReply> & future );
+
+    /**
+     * Queues requests in chunks of chunkSize requests each. Batches are not shared.
+     *
+     * @return A future that receives the reply to each request at the index of the request. It can be withdrawn
+     * with cancel().
+     */
+    QFuture<GeoregReply> submitBatch( const QList<GeoregRequest> & requests, int chunkSize, Priority priority );
+
+    int size() const;
+
+    // the number of requests waiting for a thread; a chunk of a batch counts as one
+    int queueDepth() const;
+
+    // the average and the longest time requests waited in the queue, in milliseconds
+    double averageWaitTime() const;
+    double maximumWaitTime() const;
+
+    // the number of requests that shared the georeg call of an earlier request
+    quint64 sharedRequests() const;
+
+    // the number of canceled requests that were taken out of the queue, which saved their georeg call
+    quint64 canceledQueuedRequests() const;
+    // the number of canceled requests, or chunks of batches, that were running
+    quint64 canceledRunningRequests() const;
+    // the number of places running requests did not read because they were canceled
+    quint64 canceledPlaces() const;
+
+    // the key under which request is shared: the same for requests georeg gives the same places for.
+    static QByteArray requestKey( const GeoregRequest & request );
+
+private:
+    Q_DISABLE_COPY(GeoSearchWorkerPoolBb)
+
+    class Task;
+    class Worker;
+
+    void startWorkers( int tasks );
+    void finishTask( Task * task );
+    void work();
+
+    mutable QMutex _mutex;
+    // the queued tasks by priority
+    QMap<int, QQueue<Task *> > _queue;
+    // the queued and running tasks by the key of their request
+    QHash<QByteArray, Task *> _inFlight;
+    int _queueDepth;
+    int _running;
+    int _size;
+    int _placesChunkSize;
+    QSharedPointer<GeoSearchHandlePoolBb> _handlePool;
+    QThreadPool _threads;
+
+    quint64 _dequeued;
+    qint64 _totalWaitTime;
+    qint64 _maximumWaitTime;
+    quint64 _sharedRequests;
+    quint64 _canceledQueuedRequests;
+    quint64 _canceledRunningRequests;
+    quint64 _canceledPlaces;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
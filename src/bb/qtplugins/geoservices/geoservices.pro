@@ -33,16 +33,26 @@ INCLUDEPATH += \
 # even though these are not public headers use HEADERS instead of PRIVATE_HEADERS to 
 # prevent unresolved symbol errors when the plugin is dynamically loaded
 HEADERS += \
+           GeoSearchBatchReplyBb.hpp \
+           GeoSearchCacheBb.hpp \
+           GeoSearchHandlePoolBb.hpp \
            GeoSearchManagerEngineBb.hpp \
            GeoSearchReplyBb.hpp \
+           GeoSearchStoreBb.hpp \
+           GeoSearchWorkerPoolBb.hpp \
            GeoServiceProviderFactoryBb.hpp \
            ../../../../include/private/bbmock/GeoregApi.hpp \
            ../../../bbmock/GeoregApiImpl.hpp \
            
 
 SOURCES += \
+           GeoSearchBatchReplyBb.cpp \
+           GeoSearchCacheBb.cpp \
+           GeoSearchHandlePoolBb.cpp \
            GeoSearchManagerEngineBb.cpp \
            GeoSearchReplyBb.cpp \
+           GeoSearchStoreBb.cpp \
+           GeoSearchWorkerPoolBb.cpp \
            GeoServiceProviderFactoryBb.cpp \
            ../../../bbmock/GeoregApi.cpp \
            ../../../bbmock/GeoregApiImpl.cpp \
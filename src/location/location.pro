@@ -36,13 +36,20 @@ PUBLIC_HEADERS += \
                     ../../include/public/QtLocationSubset/qgeoboundingarea.h \
                     ../../include/public/QtLocationSubset/qgeoboundingbox.h \
                     ../../include/public/QtLocationSubset/qgeoboundingcircle.h \
+                    ../../include/public/QtLocationSubset/qgeocellkey.h \
                     ../../include/public/QtLocationSubset/qgeocoordinate.h \
+                    ../../include/public/QtLocationSubset/qgeocoordinatebatch.h \
+                    ../../include/public/QtLocationSubset/qgeocoordinatevalue.h \
                     ../../include/public/QtLocationSubset/qgeoplace.h \
+                    ../../include/public/QtLocationSubset/qgeopositionhub.h \
                     ../../include/public/QtLocationSubset/qgeopositioninfo.h \
                     ../../include/public/QtLocationSubset/qgeopositioninfosource.h \
+                    ../../include/public/QtLocationSubset/qgeopreparedcircle.h \
                     ../../include/public/QtLocationSubset/qgeosatelliteinfo.h \
                     ../../include/public/QtLocationSubset/qgeosatelliteinfosource.h \
+                    ../../include/public/QtLocationSubset/qgeospatialindex.h \
                     ../../include/public/QtLocationSubset/qnmeapositioninfosource.h \
+                    ../../include/public/QtLocationSubset/qnmeasatelliteinfosource.h \
                     ../../include/public/QtLocationSubset/qgeopositioninfosourcefactory.h
 
 PRIVATE_HEADERS += \
@@ -50,8 +57,11 @@ PRIVATE_HEADERS += \
                     qgeoboundingbox_p.h \
                     qgeoboundingcircle_p.h \
                     qgeoplace_p.h \
+                    qgeopositionhub_p.h \
+                    qgeospatialindex_p.h \
                     qlocationutils_p.h \
                     qnmeapositioninfosource_p.h \
+                    qnmeasatelliteinfosource_p.h \
                     qgeocoordinate_p.h
 
 
@@ -62,12 +72,18 @@ SOURCES += \
             qgeoboundingarea.cpp \
             qgeoboundingbox.cpp \
             qgeoboundingcircle.cpp \
+            qgeocellkey.cpp \
             qgeocoordinate.cpp \
+            qgeocoordinatebatch.cpp \
             qgeoplace.cpp \
+            qgeopositionhub.cpp \
             qgeopositioninfo.cpp \
             qgeopositioninfosource.cpp \
+            qgeopreparedcircle.cpp \
             qgeosatelliteinfo.cpp \
             qgeosatelliteinfosource.cpp \
+            qgeospatialindex.cpp \
             qlocationutils.cpp \
             qnmeapositioninfosource.cpp \
+            qnmeasatelliteinfosource.cpp \
             qgeopositioninfosourcefactory.cpp
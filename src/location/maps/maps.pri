@@ -1,4 +1,5 @@
 PUBLIC_HEADERS += \
+                    ../../include/public/QtLocationSubset/qgeosearchbatchreply.h \
                     ../../include/public/QtLocationSubset/qgeosearchmanager.h \
                     ../../include/public/QtLocationSubset/qgeosearchmanagerengine.h \
                     ../../include/public/QtLocationSubset/qgeosearchreply.h \
@@ -6,12 +7,14 @@ PUBLIC_HEADERS += \
                     ../../include/public/QtLocationSubset/qgeoserviceproviderfactory.h
 
 PRIVATE_HEADERS += \
+                    maps/qgeosearchbatchreply_p.h \
                     maps/qgeosearchmanager_p.h \
                     maps/qgeosearchmanagerengine_p.h \
                     maps/qgeosearchreply_p.h \
                     maps/qgeoserviceprovider_p.h
 
 SOURCES += \
+            maps/qgeosearchbatchreply.cpp \
             maps/qgeosearchmanager.cpp \
             maps/qgeosearchmanagerengine.cpp \
             maps/qgeosearchreply.cpp \
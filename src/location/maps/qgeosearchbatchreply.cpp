@@ -0,0 +1,318 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgeosearchbatchreply.h"
+#include "qgeosearchbatchreply_p.h"
+
+QTMS_BEGIN_NAMESPACE
+/*!
+    \class QGeoSearchBatchReply
+
+    \brief The QGeoSearchBatchReply class manages a batch of geocoding or
+    reverse geocoding operations started by an instance of QGeoSearchManager.
+
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup maps-places
+        \headerfile qgeosearchbatchreply.cpp <QtLocationSubset/QGeoSearchBatchReply>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    A batch reply is returned by QGeoSearchManager::geocodeBatch() and
+    QGeoSearchManager::reverseGeocodeBatch(). It holds one result for each
+    address or coordinate of the batch, at the same index, which is made up of
+    the places found for it and of the error, if any, that occurred while
+    searching for it.
+
+    The results become available as the batch is processed, not necessarily in
+    the order of the batch. The resultsReady() signal is emitted for each range
+    of results that becomes available, followed by progress(). Once all results
+    are available finished() is emitted.
+
+    The isFinished(), error() and errorString() methods provide information
+    on whether the batch has completed and if it could be processed at all. An
+    error that affects only some addresses or coordinates of the batch is
+    reported by resultError() instead.
+
+    It is possible that a newly created QGeoSearchBatchReply may be in a
+    finished state, most commonly because an error has occurred. Since such an
+    instance will never emit the finished() or
+    error(QGeoSearchReply::Error,QString) signals, it is important to check the
+    result of isFinished() before making the connections to the signals.
+*/
+
+/*!
+    Constructs a batch reply for \a count addresses or coordinates with the
+    specified \a parent.
+*/
+QGeoSearchBatchReply::QGeoSearchBatchReply(int count, QObject *parent)
+    : QObject(parent),
+      d_ptr(new QGeoSearchBatchReplyPrivate(count)) {}
+
+/*!
+    Constructs a batch reply with a given \a error and \a errorString and the specified \a parent.
+*/
+QGeoSearchBatchReply::QGeoSearchBatchReply(QGeoSearchReply::Error error, const QString &errorString, QObject *parent)
+    : QObject(parent),
+      d_ptr(new QGeoSearchBatchReplyPrivate(error, errorString)) {}
+
+/*!
+    Destroys this batch reply object.
+*/
+QGeoSearchBatchReply::~QGeoSearchBatchReply()
+{
+    delete d_ptr;
+}
+
+/*!
+    Sets whether or not this reply has finished to \a finished.
+
+    If \a finished is true, this will cause the finished() signal to be
+    emitted.
+
+    setResultsReady() calls this function once the results of the whole batch
+    are available, so that subclasses only need to call it to finish a batch
+    early.
+*/
+void QGeoSearchBatchReply::setFinished(bool finished)
+{
+    d_ptr->isFinished = finished;
+    if (d_ptr->isFinished)
+        Q_EMIT this->finished();
+}
+
+/*!
+    Returns true if the results of all addresses or coordinates are available
+    or if an error caused the batch to come to a halt.
+*/
+bool QGeoSearchBatchReply::isFinished() const
+{
+    return d_ptr->isFinished;
+}
+
+/*!
+    Sets the error state of this reply to \a error and the textual
+    representation of the error to \a errorString.
+
+    This wil also cause error() and finished() signals to be emitted, in that
+    order.
+*/
+void QGeoSearchBatchReply::setError(QGeoSearchReply::Error error, const QString &errorString)
+{
+    d_ptr->error = error;
+    d_ptr->errorString = errorString;
+    Q_EMIT this->error(error, errorString);
+    setFinished(true);
+}
+
+/*!
+    Returns the error state of this reply.
+
+    If the result is QGeoSearchReply::NoError then the batch was processed,
+    although resultError() may report errors for some of its addresses or
+    coordinates.
+*/
+QGeoSearchReply::Error QGeoSearchBatchReply::error() const
+{
+    return d_ptr->error;
+}
+
+/*!
+    Returns the textual representation of the error state of this reply.
+
+    If no error has occurred this will return an empty string.
+*/
+QString QGeoSearchBatchReply::errorString() const
+{
+    return d_ptr->errorString;
+}
+
+/*!
+    Returns the number of addresses or coordinates in the batch.
+*/
+int QGeoSearchBatchReply::count() const
+{
+    return d_ptr->places.size();
+}
+
+/*!
+    Returns the number of addresses or coordinates whose results are
+    available.
+*/
+int QGeoSearchBatchReply::finishedCount() const
+{
+    return d_ptr->finishedCount;
+}
+
+/*!
+    Returns the places found for the address or coordinate at \a index in the
+    batch.
+
+    The list is empty until the resultsReady() signal has been emitted for a
+    range that includes \a index.
+*/
+QList<QGeoPlace> QGeoSearchBatchReply::places(int index) const
+{
+    return d_ptr->places.value(index);
+}
+
+/*!
+    Returns the error that occurred while searching for the address or
+    coordinate at \a index in the batch, or QGeoSearchReply::NoError if none
+    did.
+*/
+QGeoSearchReply::Error QGeoSearchBatchReply::resultError(int index) const
+{
+    return d_ptr->errors.value(index, QGeoSearchReply::NoError);
+}
+
+/*!
+    Sets the result of the address or coordinate at \a index in the batch to
+    \a places and \a error.
+
+    The result is not announced until setResultsReady() is called for a range
+    that includes \a index.
+*/
+void QGeoSearchBatchReply::setResult(int index, const QList<QGeoPlace> &places, QGeoSearchReply::Error error)
+{
+    if (index < 0 || index >= d_ptr->places.size())
+        return;
+
+    d_ptr->places[index] = places;
+    d_ptr->errors[index] = error;
+}
+
+/*!
+    Announces that the results of the addresses or coordinates from \a first to
+    \a last, inclusive, have been set with setResult().
+
+    This causes resultsReady() and progress() to be emitted, in that order, and
+    finished() as well once the results of the whole batch are available. Each
+    index should only be announced once.
+*/
+void QGeoSearchBatchReply::setResultsReady(int first, int last)
+{
+    if (d_ptr->isFinished || first > last)
+        return;
+
+    d_ptr->finishedCount += last - first + 1;
+    Q_EMIT resultsReady(first, last);
+    Q_EMIT progress(d_ptr->finishedCount, d_ptr->places.size());
+
+    if (!d_ptr->isFinished && d_ptr->finishedCount >= d_ptr->places.size())
+        setFinished(true);
+}
+
+/*!
+    Cancels the batch immediately. The results that are already available are
+    kept.
+
+    This will do nothing if the reply is finished.
+*/
+void QGeoSearchBatchReply::abort()
+{
+    if (!isFinished())
+        setFinished(true);
+}
+
+/*!
+    \fn void QGeoSearchBatchReply::resultsReady(int first, int last)
+
+    This signal is emitted when the results of the addresses or coordinates
+    from \a first to \a last, inclusive, have become available through
+    places() and resultError().
+*/
+/*!
+    \fn void QGeoSearchBatchReply::progress(int finished, int total)
+
+    This signal is emitted after resultsReady(), with \a finished being the
+    number of addresses or coordinates whose results are available and \a total
+    the number in the batch.
+*/
+/*!
+    \fn void QGeoSearchBatchReply::finished()
+
+    This signal is emitted when this reply has finished processing.
+
+    If error() equals QGeoSearchReply::NoError then the processing
+    finished successfully.
+
+    \note Do not delete this reply object in the slot connected to this
+    signal. Use deleteLater() instead.
+*/
+/*!
+    \fn void QGeoSearchBatchReply::error(QGeoSearchReply::Error error, const QString &errorString)
+
+    This signal is emitted when an error prevents the batch from being
+    processed. The finished() signal will probably follow.
+
+    The error will be described by the error code \a error. If \a errorString is
+    not empty it will contain a textual description of the error.
+
+    \note Do not delete this reply object in the slot connected to this
+    signal. Use deleteLater() instead.
+*/
+
+/*******************************************************************************
+*******************************************************************************/
+
+QGeoSearchBatchReplyPrivate::QGeoSearchBatchReplyPrivate(int count)
+    : error(QGeoSearchReply::NoError),
+      errorString(""),
+      isFinished(false),
+      places(qMax(count, 0)),
+      errors(qMax(count, 0), QGeoSearchReply::NoError),
+      finishedCount(0) {}
+
+QGeoSearchBatchReplyPrivate::QGeoSearchBatchReplyPrivate(QGeoSearchReply::Error error, const QString &errorString)
+    : error(error),
+      errorString(errorString),
+      isFinished(true),
+      finishedCount(0) {}
+
+QGeoSearchBatchReplyPrivate::~QGeoSearchBatchReplyPrivate() {}
+
+#include "moc_qgeosearchbatchreply.cpp"
+
+QTMS_END_NAMESPACE
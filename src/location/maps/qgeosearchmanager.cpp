@@ -334,6 +334,72 @@ QGeoSearchReply* QGeoSearchManager::reverseGeocode(const QGeoCoordinate &coordin
     return d_ptr->engine->reverseGeocode(coordinate, bounds);
 }
 
+/*!
+    Begins the geocoding of each of \a addresses, as geocode() would, for
+    example to import a list of addresses.
+
+    A single QGeoSearchBatchReply object will be returned, rather than a
+    QGeoSearchReply for each address. It holds the result of each address at
+    the same index as the address. The results become available in chunks as
+    they are found, which is reported by the
+    QGeoSearchBatchReply::resultsReady() and QGeoSearchBatchReply::progress()
+    signals, and QGeoSearchBatchReply::finished() is emitted once all of them
+    are available.
+
+    If supportsGeocoding() returns false an
+    QGeoSearchReply::UnsupportedOptionError will occur.
+
+    If \a bounds is non-null and a valid QGeoBoundingArea it is used for every
+    address, as described for geocode().
+
+    The user is responsible for deleting the returned reply object, although
+    this can be done in the slot connected to QGeoSearchBatchReply::finished()
+    or QGeoSearchBatchReply::error() with deleteLater().
+
+    Note that the BB10 QGeoSearchManager processes the batch at a lower
+    priority than requests made with geocode() and reverseGeocode(), so that
+    a large batch does not hold them up.
+
+    \since 1.2
+*/
+QGeoSearchBatchReply* QGeoSearchManager::geocodeBatch(const QList<QGeoAddress> &addresses, QGeoBoundingArea *bounds)
+{
+    return d_ptr->engine->geocodeBatch(addresses, bounds);
+}
+
+/*!
+    Begins the reverse geocoding of each of \a coordinates, as
+    reverseGeocode() would.
+
+    A single QGeoSearchBatchReply object will be returned, rather than a
+    QGeoSearchReply for each coordinate. It holds the result of each coordinate
+    at the same index as the coordinate. The results become available in
+    chunks as they are found, which is reported by the
+    QGeoSearchBatchReply::resultsReady() and QGeoSearchBatchReply::progress()
+    signals, and QGeoSearchBatchReply::finished() is emitted once all of them
+    are available.
+
+    If supportsReverseGeocoding() returns false an
+    QGeoSearchReply::UnsupportedOptionError will occur.
+
+    If \a bounds is non-null and a valid QGeoBoundingArea it will be used to
+    limit the results of every coordinate to those that are contained within
+    \a bounds.
+
+    The user is responsible for deleting the returned reply object, although
+    this can be done in the slot connected to QGeoSearchBatchReply::finished()
+    or QGeoSearchBatchReply::error() with deleteLater().
+
+    Note that the BB10 QGeoSearchManager uses the "boundary" property for the
+    whole batch, as described for reverseGeocode().
+
+    \since 1.2
+*/
+QGeoSearchBatchReply* QGeoSearchManager::reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates, QGeoBoundingArea *bounds)
+{
+    return d_ptr->engine->reverseGeocodeBatch(coordinates, bounds);
+}
+
 /*!
     Begins searching for a place matching \a searchString.  The value of
     \a searchTypes will determine whether the search is for addresses only,
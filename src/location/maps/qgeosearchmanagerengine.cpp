@@ -241,6 +241,81 @@ QGeoSearchReply* QGeoSearchManagerEngine::reverseGeocode(const QGeoCoordinate &c
                                "Reverse geocoding is not supported by this service provider.", this);
 }
 
+/*!
+    Begins the geocoding of each of \a addresses.
+
+    A QGeoSearchBatchReply object will be returned, which holds the result of
+    each address at the same index as the address. The results become
+    available as they are found, which is reported by the
+    QGeoSearchBatchReply::resultsReady() and QGeoSearchBatchReply::progress()
+    signals.
+
+    If supportsGeocoding() returns false an
+    QGeoSearchReply::UnsupportedOptionError will occur.
+
+    If \a bounds is non-null and a valid QGeoBoundingArea it is used for
+    every address, as described for geocode().
+
+    The default implementation geocodes the addresses with geocode(), a few at
+    a time, and deletes the replies it receives from it. Those replies are
+    still announced by the finished() and error() signals of this engine.
+    Subclasses that can process a batch more efficiently, for example by
+    sending several addresses in one request, should reimplement this function.
+
+    The user is responsible for deleting the returned reply object, although
+    this can be done in the slot connected to QGeoSearchBatchReply::finished()
+    or QGeoSearchBatchReply::error() with deleteLater().
+
+    \since 1.2
+*/
+QGeoSearchBatchReply* QGeoSearchManagerEngine::geocodeBatch(const QList<QGeoAddress> &addresses,
+        QGeoBoundingArea *bounds)
+{
+    if (!supportsGeocoding())
+        return new QGeoSearchBatchReply(QGeoSearchReply::UnsupportedOptionError,
+                                        "Geocoding is not supported by this service provider.", this);
+
+    return new QGeoSearchManagerEngineBatchReply(this, addresses, bounds);
+}
+
+/*!
+    Begins the reverse geocoding of each of \a coordinates.
+
+    A QGeoSearchBatchReply object will be returned, which holds the result of
+    each coordinate at the same index as the coordinate. The results become
+    available as they are found, which is reported by the
+    QGeoSearchBatchReply::resultsReady() and QGeoSearchBatchReply::progress()
+    signals.
+
+    If supportsReverseGeocoding() returns false an
+    QGeoSearchReply::UnsupportedOptionError will occur.
+
+    If \a bounds is non-null and a valid QGeoBoundingArea it will be used to
+    limit the results of every coordinate to those that are contained by
+    \a bounds.
+
+    The default implementation reverse geocodes the coordinates with
+    reverseGeocode(), a few at a time, and deletes the replies it receives
+    from it. Those replies are still announced by the finished() and error()
+    signals of this engine. Subclasses that can process a batch more
+    efficiently should reimplement this function.
+
+    The user is responsible for deleting the returned reply object, although
+    this can be done in the slot connected to QGeoSearchBatchReply::finished()
+    or QGeoSearchBatchReply::error() with deleteLater().
+
+    \since 1.2
+*/
+QGeoSearchBatchReply* QGeoSearchManagerEngine::reverseGeocodeBatch(const QList<QGeoCoordinate> &coordinates,
+        QGeoBoundingArea *bounds)
+{
+    if (!supportsReverseGeocoding())
+        return new QGeoSearchBatchReply(QGeoSearchReply::UnsupportedOptionError,
+                                        "Reverse geocoding is not supported by this service provider.", this);
+
+    return new QGeoSearchManagerEngineBatchReply(this, coordinates, bounds);
+}
+
 /*!
     Begins searching for a place matching \a searchString.  The value of
     \a searchTypes normally determines whether the search is for addresses only,
@@ -417,6 +492,125 @@ QGeoSearchManagerEnginePrivate::~QGeoSearchManagerEnginePrivate()
 {
 }
 
+/*******************************************************************************
+*******************************************************************************/
+
+// The number of replies of geocode() or reverseGeocode() a batch waits for at the same time.
+static const int MaxPendingBatchRequests = 4;
+
+QGeoSearchManagerEngineBatchReply::QGeoSearchManagerEngineBatchReply(QGeoSearchManagerEngine *engine,
+        const QList<QGeoAddress> &addresses,
+        QGeoBoundingArea *bounds)
+    : QGeoSearchBatchReply(addresses.size(), engine),
+      engine(engine),
+      addresses(addresses),
+      reverse(false),
+      bounds(0),
+      next(0)
+{
+    setBounds(bounds);
+
+    // start on the next turn of the event loop, so that the caller has the chance to connect to the signals first.
+    QMetaObject::invokeMethod(this, "startRequests", Qt::QueuedConnection);
+}
+
+QGeoSearchManagerEngineBatchReply::QGeoSearchManagerEngineBatchReply(QGeoSearchManagerEngine *engine,
+        const QList<QGeoCoordinate> &coordinates,
+        QGeoBoundingArea *bounds)
+    : QGeoSearchBatchReply(coordinates.size(), engine),
+      engine(engine),
+      coordinates(coordinates),
+      reverse(true),
+      bounds(0),
+      next(0)
+{
+    setBounds(bounds);
+    QMetaObject::invokeMethod(this, "startRequests", Qt::QueuedConnection);
+}
+
+QGeoSearchManagerEngineBatchReply::~QGeoSearchManagerEngineBatchReply()
+{
+    abortRequests();
+}
+
+void QGeoSearchManagerEngineBatchReply::abort()
+{
+    if (isFinished())
+        return;
+
+    abortRequests();
+    QGeoSearchBatchReply::abort();
+}
+
+// The requests are made over time, so the caller's bounds are copied.
+void QGeoSearchManagerEngineBatchReply::setBounds(QGeoBoundingArea *bounds)
+{
+    if (!bounds)
+        return;
+
+    if (bounds->type() == QGeoBoundingArea::BoxType) {
+        boundingBox = *static_cast<QGeoBoundingBox*>(bounds);
+        this->bounds = &boundingBox;
+    } else if (bounds->type() == QGeoBoundingArea::CircleType) {
+        boundingCircle = *static_cast<QGeoBoundingCircle*>(bounds);
+        this->bounds = &boundingCircle;
+    }
+}
+
+void QGeoSearchManagerEngineBatchReply::startRequests()
+{
+    // an empty batch has no request whose result would finish it
+    if (count() == 0) {
+        if (!isFinished())
+            setFinished(true);
+        return;
+    }
+
+    while (!isFinished() && pending.size() < MaxPendingBatchRequests && next < count()) {
+        int index = next++;
+        QGeoSearchReply *reply = reverse ? engine->reverseGeocode(coordinates.at(index), bounds)
+                                         : engine->geocode(addresses.at(index), bounds);
+
+        // a reply may be finished as soon as it is created, most commonly because of an error.
+        if (reply->isFinished()) {
+            takeResult(reply, index);
+            continue;
+        }
+
+        pending.insert(reply, index);
+        connect(reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    }
+}
+
+void QGeoSearchManagerEngineBatchReply::replyFinished()
+{
+    QGeoSearchReply *reply = qobject_cast<QGeoSearchReply*>(sender());
+    if (!reply || !pending.contains(reply))
+        return;
+
+    takeResult(reply, pending.take(reply));
+    startRequests();
+}
+
+void QGeoSearchManagerEngineBatchReply::takeResult(QGeoSearchReply *reply, int index)
+{
+    setResult(index, reply->places(), reply->error());
+    reply->deleteLater();
+    setResultsReady(index, index);
+}
+
+void QGeoSearchManagerEngineBatchReply::abortRequests()
+{
+    QList<QGeoSearchReply*> replies = pending.keys();
+    pending.clear();
+    for (int i = 0; i < replies.size(); ++i) {
+        replies.at(i)->disconnect(this);
+        replies.at(i)->abort();
+        replies.at(i)->deleteLater();
+    }
+}
+
 #include "moc_qgeosearchmanagerengine.cpp"
+#include "moc_qgeosearchmanagerengine_p.cpp"
 
 QTMS_END_NAMESPACE
@@ -54,7 +54,14 @@
 //
 
 #include "qgeosearchmanagerengine.h"
+#include "qgeosearchbatchreply.h"
 
+#include "qgeoaddress.h"
+#include "qgeoboundingbox.h"
+#include "qgeoboundingcircle.h"
+#include "qgeocoordinate.h"
+
+#include <QHash>
 #include <QList>
 #include <QLocale>
 
@@ -79,6 +86,44 @@ private:
     Q_DISABLE_COPY(QGeoSearchManagerEnginePrivate)
 };
 
+class QGeoSearchManagerEngineBatchReply : public QGeoSearchBatchReply
+{
+    Q_OBJECT
+public:
+    QGeoSearchManagerEngineBatchReply(QGeoSearchManagerEngine *engine,
+                                      const QList<QGeoAddress> &addresses,
+                                      QGeoBoundingArea *bounds);
+    QGeoSearchManagerEngineBatchReply(QGeoSearchManagerEngine *engine,
+                                      const QList<QGeoCoordinate> &coordinates,
+                                      QGeoBoundingArea *bounds);
+    ~QGeoSearchManagerEngineBatchReply();
+
+    void abort();
+
+private Q_SLOTS:
+    void startRequests();
+    void replyFinished();
+
+private:
+    void setBounds(QGeoBoundingArea *bounds);
+    void takeResult(QGeoSearchReply *reply, int index);
+    void abortRequests();
+
+    QGeoSearchManagerEngine *engine;
+    QList<QGeoAddress> addresses;
+    QList<QGeoCoordinate> coordinates;
+    bool reverse;
+
+    QGeoBoundingArea *bounds;
+    QGeoBoundingBox boundingBox;
+    QGeoBoundingCircle boundingCircle;
+
+    QHash<QGeoSearchReply*, int> pending;
+    int next;
+
+    Q_DISABLE_COPY(QGeoSearchManagerEngineBatchReply)
+};
+
 QTMS_END_NAMESPACE
 
 #endif
@@ -78,6 +78,10 @@ QTMS_BEGIN_NAMESPACE
 
     If the operation completes successfully the results will be able to be
     accessed with places().
+
+    Some service providers deliver the places in parts while the operation is
+    still running. The placesAdded() signal is emitted for each part, so that
+    the places found so far can be shown before the operation has finished.
 */
 
 /*!
@@ -228,6 +232,28 @@ void QGeoSearchReply::addPlace(const QGeoPlace &place)
     d_ptr->places.append(place);
 }
 
+/*!
+    Appends \a places to the list of places in this reply.
+
+    This causes the placesAdded() signal to be emitted, unless \a places is
+    empty.
+
+    \since 1.2
+*/
+void QGeoSearchReply::addPlaces(const QList<QGeoPlace> &places)
+{
+    if (places.isEmpty())
+        return;
+
+    int first = d_ptr->places.size();
+    if (first == 0)
+        d_ptr->places = places;
+    else
+        d_ptr->places += places;
+
+    Q_EMIT this->placesAdded(first, d_ptr->places.size() - 1);
+}
+
 /*!
     Sets the list of \a places in the reply.
 */
@@ -316,6 +342,17 @@ void QGeoSearchReply::setOffset(int offset)
     \note Do not delete this reply object in the slot connected to this
     signal. Use deleteLater() instead.
 */
+/*!
+    \fn void QGeoSearchReply::placesAdded(int first, int last)
+
+    This signal is emitted when places have been added to this reply before it
+    has finished, which only some service providers do. The places from index
+    \a first to index \a last, inclusive, of places() are new.
+
+    The finished() signal follows once all the places have been added.
+
+    \since 1.2
+*/
 
 /*******************************************************************************
 *******************************************************************************/
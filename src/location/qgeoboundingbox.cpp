@@ -202,7 +202,7 @@ void QGeoBoundingBox::setTopLeft(const QGeoCoordinate &topLeft)
 */
 QGeoCoordinate QGeoBoundingBox::topLeft() const
 {
-    return d_ptr->topLeft;
+    return d_ptr->topLeft.toCoordinate();
 }
 
 /*!
@@ -260,7 +260,7 @@ void QGeoBoundingBox::setBottomRight(const QGeoCoordinate &bottomRight)
 */
 QGeoCoordinate QGeoBoundingBox::bottomRight() const
 {
-    return d_ptr->bottomRight;
+    return d_ptr->bottomRight.toCoordinate();
 }
 
 /*!
@@ -317,8 +317,8 @@ void QGeoBoundingBox::setCenter(const QGeoCoordinate &center)
         brLon = 180.0;
     }
 
-    d_ptr->topLeft = QGeoCoordinate(tlLat, tlLon);
-    d_ptr->bottomRight = QGeoCoordinate(brLat, brLon);
+    d_ptr->topLeft = QGeoCoordinateValue(tlLat, tlLon);
+    d_ptr->bottomRight = QGeoCoordinateValue(brLat, brLon);
 }
 
 /*!
@@ -389,8 +389,8 @@ void QGeoBoundingBox::setWidth(double degreesWidth)
     if (brLon > 180.0)
         brLon -= 360.0;
 
-    d_ptr->topLeft = QGeoCoordinate(tlLat, tlLon);
-    d_ptr->bottomRight = QGeoCoordinate(brLat, brLon);
+    d_ptr->topLeft = QGeoCoordinateValue(tlLat, tlLon);
+    d_ptr->bottomRight = QGeoCoordinateValue(brLat, brLon);
 }
 
 /*!
@@ -469,8 +469,8 @@ void QGeoBoundingBox::setHeight(double degreesHeight)
         brLat = -90.0;
     }
 
-    d_ptr->topLeft = QGeoCoordinate(tlLat, tlLon);
-    d_ptr->bottomRight = QGeoCoordinate(brLat, brLon);
+    d_ptr->topLeft = QGeoCoordinateValue(tlLat, tlLon);
+    d_ptr->bottomRight = QGeoCoordinateValue(brLat, brLon);
 }
 
 /*!
@@ -645,8 +645,8 @@ void QGeoBoundingBox::translate(double degreesLatitude, double degreesLongitude)
     if (brLat < -90.0)
         brLat = -90.0;
 
-    d_ptr->topLeft = QGeoCoordinate(tlLat, tlLon);
-    d_ptr->bottomRight = QGeoCoordinate(brLat, brLon);
+    d_ptr->topLeft = QGeoCoordinateValue(tlLat, tlLon);
+    d_ptr->bottomRight = QGeoCoordinateValue(brLat, brLon);
 }
 
 /*!
@@ -767,8 +767,8 @@ QGeoBoundingBox& QGeoBoundingBox::operator |= (const QGeoBoundingBox & boundingB
         right = 180;
     }
 
-    d_ptr->topLeft = QGeoCoordinate(top, left);
-    d_ptr->bottomRight = QGeoCoordinate(bottom, right);
+    d_ptr->topLeft = QGeoCoordinateValue(top, left);
+    d_ptr->bottomRight = QGeoCoordinateValue(bottom, right);
 
     return *this;
 }
@@ -53,7 +53,7 @@
 // We mean it.
 //
 
-#include "qgeocoordinate.h"
+#include "qgeocoordinatevalue.h"
 
 #include <QSharedData>
 
@@ -71,8 +71,8 @@ public:
 
     bool operator== (const QGeoBoundingBoxPrivate &other) const;
 
-    QGeoCoordinate topLeft;
-    QGeoCoordinate bottomRight;
+    QGeoCoordinateValue topLeft;
+    QGeoCoordinateValue bottomRight;
 };
 
 QTMS_END_NAMESPACE
@@ -163,6 +163,7 @@ bool QGeoBoundingCircle::isEmpty() const
 void QGeoBoundingCircle::setCenter(const QGeoCoordinate &center)
 {
     d_ptr->center = center;
+    d_ptr->prepare();
 }
 
 /*!
@@ -170,7 +171,7 @@ void QGeoBoundingCircle::setCenter(const QGeoCoordinate &center)
 */
 QGeoCoordinate QGeoBoundingCircle::center() const
 {
-    return d_ptr->center;
+    return d_ptr->center.toCoordinate();
 }
 
 /*!
@@ -179,6 +180,7 @@ QGeoCoordinate QGeoBoundingCircle::center() const
 void QGeoBoundingCircle::setRadius(qreal radius)
 {
     d_ptr->radius = radius;
+    d_ptr->prepare();
 }
 
 /*!
@@ -196,13 +198,7 @@ qreal QGeoBoundingCircle::radius() const
 bool QGeoBoundingCircle::contains(const QGeoCoordinate &coordinate) const
 {
 
-    if (!isValid() || !coordinate.isValid())
-        return false;
-
-    if (d_ptr->center.distanceTo(coordinate) <= d_ptr->radius)
-        return true;
-
-    return false;
+    return d_ptr->prepared.contains(coordinate);
 }
 
 /*!
@@ -243,7 +239,8 @@ void QGeoBoundingCircle::translate(double degreesLatitude, double degreesLongitu
             lon -= 180;
     }
 
-    d_ptr->center = QGeoCoordinate(lat, lon);
+    d_ptr->center = QGeoCoordinateValue(lat, lon);
+    d_ptr->prepare();
 }
 
 /*!
@@ -272,12 +269,14 @@ QGeoBoundingCirclePrivate::QGeoBoundingCirclePrivate()
 QGeoBoundingCirclePrivate::QGeoBoundingCirclePrivate(const QGeoCoordinate &center, qreal radius)
         : QSharedData(),
         center(center),
-        radius(radius) {}
+        radius(radius),
+        prepared(this->center, radius) {}
 
 QGeoBoundingCirclePrivate::QGeoBoundingCirclePrivate(const QGeoBoundingCirclePrivate &other)
         : QSharedData(),
         center(other.center),
-        radius(other.radius) {}
+        radius(other.radius),
+        prepared(other.prepared) {}
 
 QGeoBoundingCirclePrivate::~QGeoBoundingCirclePrivate() {}
 
@@ -285,6 +284,7 @@ QGeoBoundingCirclePrivate& QGeoBoundingCirclePrivate::operator= (const QGeoBound
 {
     center = other.center;
     radius = other.radius;
+    prepared = other.prepared;
 
     return *this;
 }
@@ -294,5 +294,10 @@ bool QGeoBoundingCirclePrivate::operator== (const QGeoBoundingCirclePrivate &oth
     return ((center == other.center) && (radius == other.radius));
 }
 
+void QGeoBoundingCirclePrivate::prepare()
+{
+    prepared = QGeoPreparedCircle(center, radius);
+}
+
 QTMS_END_NAMESPACE
 
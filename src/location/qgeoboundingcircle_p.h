@@ -53,7 +53,8 @@
 // We mean it.
 //
 
-#include "qgeocoordinate.h"
+#include "qgeocoordinatevalue.h"
+#include "qgeopreparedcircle.h"
 
 #include <QSharedData>
 
@@ -71,8 +72,13 @@ public:
 
     bool operator== (const QGeoBoundingCirclePrivate &other) const;
 
-    QGeoCoordinate center;
+    void prepare();
+
+    QGeoCoordinateValue center;
     qreal radius;
+    // center and radius, prepared for contains(); call prepare() after
+    // changing either.
+    QGeoPreparedCircle prepared;
 };
 
 QTMS_END_NAMESPACE
@@ -0,0 +1,580 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qgeocellkey.h"
+#include "qgeoboundingcircle.h"
+#include "qgeopreparedcircle.h"
+
+#include <qnumeric.h>
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__BMI2__) && defined(__x86_64__)
+#  include <immintrin.h>
+#  define QGEOCELLKEY_BMI2
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+QTMS_BEGIN_NAMESPACE
+
+static const char qgeocellkey_GEOHASH_ALPHABET[] = "0123456789bcdefghjkmnpqrstuvwxyz";
+static const int qgeocellkey_MAX_GEOHASH_PRECISION = 12;
+static const int qgeocellkey_MAX_QUADKEY_LEVEL = 23;
+// The latitude at which the square Mercator map of the quadkey tiles ends.
+static const double qgeocellkey_MAX_MERCATOR_LATITUDE = 85.05112878;
+
+// Moves bit i of x to bit 2i.
+static inline quint64 qgeocellkey_spread(quint32 x)
+{
+#if defined(QGEOCELLKEY_BMI2)
+    return _pdep_u64(x, Q_UINT64_C(0x5555555555555555));
+#else
+    quint64 v = x;
+    v = (v | (v << 16)) & Q_UINT64_C(0x0000FFFF0000FFFF);
+    v = (v | (v << 8)) & Q_UINT64_C(0x00FF00FF00FF00FF);
+    v = (v | (v << 4)) & Q_UINT64_C(0x0F0F0F0F0F0F0F0F);
+    v = (v | (v << 2)) & Q_UINT64_C(0x3333333333333333);
+    v = (v | (v << 1)) & Q_UINT64_C(0x5555555555555555);
+    return v;
+#endif
+}
+
+// Moves bit 2i of x to bit i, dropping the odd bits.
+static inline quint32 qgeocellkey_compact(quint64 x)
+{
+#if defined(QGEOCELLKEY_BMI2)
+    return quint32(_pext_u64(x, Q_UINT64_C(0x5555555555555555)));
+#else
+    quint64 v = x & Q_UINT64_C(0x5555555555555555);
+    v = (v | (v >> 1)) & Q_UINT64_C(0x3333333333333333);
+    v = (v | (v >> 2)) & Q_UINT64_C(0x0F0F0F0F0F0F0F0F);
+    v = (v | (v >> 4)) & Q_UINT64_C(0x00FF00FF00FF00FF);
+    v = (v | (v >> 8)) & Q_UINT64_C(0x0000FFFF0000FFFF);
+    v = (v | (v >> 16)) & Q_UINT64_C(0x00000000FFFFFFFF);
+    return quint32(v);
+#endif
+}
+
+// The index of the cell of 2^bits equal cells over [0, 1) that value falls in.
+static inline quint32 qgeocellkey_quantize(double value, int bits)
+{
+    double cells = double(Q_UINT64_C(1) << bits);
+    double cell = floor(value * cells);
+    if (cell < 0)
+        return 0;
+    if (cell >= cells)
+        return quint32(cells - 1);
+    return quint32(cell);
+}
+
+/*
+    Both kinds of key name a cell by its level and its column x and row y in
+    a grid of 2^longitudeBits by 2^latitudeBits cells, and interleave the bits
+    of x and y, most significant first, into the key.
+
+    A geohash of n characters has 5n bits, alternately of longitude and
+    latitude starting with longitude, over an equirectangular grid that
+    starts at (-90, -180). A quadkey of n digits has n bits of each, with
+    the x bit the lower of each digit, over the Web Mercator grid of map
+    tiles that starts at the top left, (85.05, -180).
+*/
+enum QGeoCellKeyScheme {
+    QGeoCellKeyGeohash,
+    QGeoCellKeyQuadKey
+};
+
+static inline int qgeocellkey_longitudeBits(QGeoCellKeyScheme scheme, int level)
+{
+    return scheme == QGeoCellKeyGeohash ? (5 * level + 1) / 2 : level;
+}
+
+static inline int qgeocellkey_latitudeBits(QGeoCellKeyScheme scheme, int level)
+{
+    return scheme == QGeoCellKeyGeohash ? 5 * level / 2 : level;
+}
+
+static inline quint64 qgeocellkey_interleave(QGeoCellKeyScheme scheme, int level, quint32 x, quint32 y)
+{
+    // The top bit of a geohash is a longitude bit, so with an even number
+    // of bits in total longitude has the odd positions.
+    if (scheme == QGeoCellKeyGeohash && (5 * level) % 2 == 0)
+        return (qgeocellkey_spread(x) << 1) | qgeocellkey_spread(y);
+    return qgeocellkey_spread(x) | (qgeocellkey_spread(y) << 1);
+}
+
+static inline void qgeocellkey_deinterleave(QGeoCellKeyScheme scheme, int level, quint64 bits,
+                                            quint32 *x, quint32 *y)
+{
+    if (scheme == QGeoCellKeyGeohash && (5 * level) % 2 == 0) {
+        *x = qgeocellkey_compact(bits >> 1);
+        *y = qgeocellkey_compact(bits);
+    } else {
+        *x = qgeocellkey_compact(bits);
+        *y = qgeocellkey_compact(bits >> 1);
+    }
+}
+
+static inline double qgeocellkey_mercatorY(double latitude)
+{
+    latitude = qBound(-qgeocellkey_MAX_MERCATOR_LATITUDE, latitude, qgeocellkey_MAX_MERCATOR_LATITUDE);
+    double sinLatitude = sin(latitude * M_PI / 180);
+    return 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+}
+
+static inline double qgeocellkey_mercatorLatitude(double y)
+{
+    return 90 - 360 * atan(exp((y - 0.5) * 2 * M_PI)) / M_PI;
+}
+
+static void qgeocellkey_cell(QGeoCellKeyScheme scheme, int level, double latitude, double longitude,
+                             quint32 *x, quint32 *y)
+{
+    *x = qgeocellkey_quantize((longitude + 180) / 360, qgeocellkey_longitudeBits(scheme, level));
+    if (scheme == QGeoCellKeyGeohash)
+        *y = qgeocellkey_quantize((latitude + 90) / 180, qgeocellkey_latitudeBits(scheme, level));
+    else
+        *y = qgeocellkey_quantize(qgeocellkey_mercatorY(latitude), level);
+}
+
+struct QGeoCellKeyBounds
+{
+    double north;
+    double south;
+    double west;
+    double east;
+};
+
+static QGeoCellKeyBounds qgeocellkey_bounds(QGeoCellKeyScheme scheme, int level, quint32 x, quint32 y)
+{
+    QGeoCellKeyBounds bounds;
+    double columns = double(Q_UINT64_C(1) << qgeocellkey_longitudeBits(scheme, level));
+    double rows = double(Q_UINT64_C(1) << qgeocellkey_latitudeBits(scheme, level));
+    bounds.west = x / columns * 360 - 180;
+    bounds.east = (x + 1) / columns * 360 - 180;
+    if (scheme == QGeoCellKeyGeohash) {
+        bounds.south = y / rows * 180 - 90;
+        bounds.north = (y + 1) / rows * 180 - 90;
+    } else {
+        bounds.north = qgeocellkey_mercatorLatitude(y / rows);
+        bounds.south = qgeocellkey_mercatorLatitude((y + 1) / rows);
+    }
+    return bounds;
+}
+
+static QString qgeocellkey_toString(QGeoCellKeyScheme scheme, int level, quint64 bits)
+{
+    QString key(level, Qt::Uninitialized);
+    QChar *data = key.data();
+    if (scheme == QGeoCellKeyGeohash) {
+        for (int i = level - 1; i >= 0; --i) {
+            data[i] = QLatin1Char(qgeocellkey_GEOHASH_ALPHABET[bits & 0x1f]);
+            bits >>= 5;
+        }
+    } else {
+        for (int i = level - 1; i >= 0; --i) {
+            data[i] = QLatin1Char('0' + int(bits & 0x3));
+            bits >>= 2;
+        }
+    }
+    return key;
+}
+
+// Returns false if key is empty, too long or has a character that is not a
+// digit of the scheme.
+static bool qgeocellkey_fromString(QGeoCellKeyScheme scheme, const QString &key,
+                                   quint32 *x, quint32 *y)
+{
+    int level = key.length();
+    int maxLevel = scheme == QGeoCellKeyGeohash ? qgeocellkey_MAX_GEOHASH_PRECISION
+                                                : qgeocellkey_MAX_QUADKEY_LEVEL;
+    if (level == 0 || level > maxLevel)
+        return false;
+
+    quint64 bits = 0;
+    for (int i = 0; i < level; ++i) {
+        ushort c = key.at(i).toLower().unicode();
+        if (scheme == QGeoCellKeyGeohash) {
+            const char *digit = c < 128 ? strchr(qgeocellkey_GEOHASH_ALPHABET, char(c)) : 0;
+            if (!digit || c == 0)
+                return false;
+            bits = (bits << 5) | quint64(digit - qgeocellkey_GEOHASH_ALPHABET);
+        } else {
+            if (c < '0' || c > '3')
+                return false;
+            bits = (bits << 2) | quint64(c - '0');
+        }
+    }
+    qgeocellkey_deinterleave(scheme, level, bits, x, y);
+    return true;
+}
+
+// How many degrees east of reference the meridian at longitude is, between
+// -180 and 180.
+static inline double qgeocellkey_longitudeDelta(double reference, double longitude)
+{
+    return fmod(longitude - reference + 540.0, 360.0) - 180.0;
+}
+
+/*
+    Returns the latitude on the meridian dlon radians from a point at
+    latitude radians where the distance from the point has its one turning
+    point: the nearest point if the meridian is less than a quarter turn
+    away, and the farthest otherwise.
+*/
+static inline double qgeocellkey_meridianTurningPoint(double latitude, double dlon)
+{
+    double c = cos(dlon);
+    if (c == 0.0)
+        return latitude >= 0 ? -M_PI / 2 : M_PI / 2;
+    return atan(tan(latitude) / c);
+}
+
+// What a covering needs to know about the area it covers.
+class QGeoCellKeyArea
+{
+public:
+    explicit QGeoCellKeyArea(const QGeoBoundingArea &area)
+        : m_type(area.type()),
+          m_top(0), m_bottom(0), m_left(0), m_right(0)
+    {
+        if (m_type == QGeoBoundingArea::BoxType) {
+            const QGeoBoundingBox &box = static_cast<const QGeoBoundingBox &>(area);
+            m_top = box.topLeft().latitude();
+            m_bottom = box.bottomRight().latitude();
+            m_left = box.topLeft().longitude();
+            m_right = box.bottomRight().longitude();
+        } else {
+            m_circle = QGeoPreparedCircle(static_cast<const QGeoBoundingCircle &>(area));
+        }
+    }
+
+    bool intersects(const QGeoCellKeyBounds &cell) const {
+        if (m_type == QGeoBoundingArea::BoxType) {
+            // Cells own their south and west edges, and the northernmost
+            // and easternmost cells their other edges as well.
+            if (cell.south > m_top || (cell.north <= m_bottom && cell.north < 90.0))
+                return false;
+            if (m_left <= m_right)
+                return overlaps(cell, m_left, m_right);
+            return overlaps(cell, m_left, 180.0) || overlaps(cell, -180.0, m_right);
+        }
+        return m_circle.contains(closestPoint(cell));
+    }
+
+    bool contains(const QGeoCellKeyBounds &cell) const {
+        if (m_type == QGeoBoundingArea::BoxType) {
+            if (cell.north > m_top || cell.south < m_bottom)
+                return false;
+            if (m_left <= m_right)
+                return cell.west >= m_left && cell.east <= m_right;
+            return cell.west >= m_left || cell.east <= m_right;
+        }
+
+        // The farthest point of the cell is a corner, the point opposite
+        // the center or the farthest point of a meridian edge.
+        double latitude = m_circle.center().latitude();
+        double longitude = m_circle.center().longitude();
+        double opposite = longitude > 0 ? longitude - 180.0 : longitude + 180.0;
+        if (opposite > cell.west && opposite < cell.east)
+            return false;
+        if (!m_circle.contains(QGeoCoordinateValue(cell.north, cell.west))
+                || !m_circle.contains(QGeoCoordinateValue(cell.north, cell.east))
+                || !m_circle.contains(QGeoCoordinateValue(cell.south, cell.west))
+                || !m_circle.contains(QGeoCoordinateValue(cell.south, cell.east)))
+            return false;
+
+        const double edges[2] = { cell.west, cell.east };
+        for (int i = 0; i < 2; ++i) {
+            double dlon = qgeocellkey_longitudeDelta(longitude, edges[i]) * M_PI / 180;
+            if (cos(dlon) >= 0)
+                continue;
+            double farthest = qgeocellkey_meridianTurningPoint(latitude * M_PI / 180, dlon) * 180 / M_PI;
+            if (farthest > cell.south && farthest < cell.north
+                    && !m_circle.contains(QGeoCoordinateValue(farthest, edges[i])))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    static bool overlaps(const QGeoCellKeyBounds &cell, double west, double east) {
+        return cell.west <= east && (cell.east > west || cell.east >= 180.0);
+    }
+
+    // The point of the cell nearest to the circle's center.
+    QGeoCoordinateValue closestPoint(const QGeoCellKeyBounds &cell) const {
+        double latitude = m_circle.center().latitude();
+        double longitude = m_circle.center().longitude();
+        if (longitude >= cell.west && longitude <= cell.east)
+            return QGeoCoordinateValue(qBound(cell.south, latitude, cell.north), longitude);
+
+        // Along every parallel the nearest point of the cell is on the
+        // meridian edge nearer in longitude.
+        double toWest = qgeocellkey_longitudeDelta(longitude, cell.west);
+        double toEast = qgeocellkey_longitudeDelta(longitude, cell.east);
+        double edge = fabs(toWest) < fabs(toEast) ? cell.west : cell.east;
+        double dlon = qMin(fabs(toWest), fabs(toEast)) * M_PI / 180;
+        double phi = latitude * M_PI / 180;
+
+        if (cos(dlon) > 0) {
+            double nearest = qgeocellkey_meridianTurningPoint(phi, dlon) * 180 / M_PI;
+            return QGeoCoordinateValue(qBound(cell.south, nearest, cell.north), edge);
+        }
+
+        // The turning point is the farthest point, so the nearest is one of
+        // the ends of the edge.
+        double south = cell.south * M_PI / 180;
+        double north = cell.north * M_PI / 180;
+        double cosSouth = sin(phi) * sin(south) + cos(phi) * cos(south) * cos(dlon);
+        double cosNorth = sin(phi) * sin(north) + cos(phi) * cos(north) * cos(dlon);
+        return QGeoCoordinateValue(cosSouth > cosNorth ? cell.south : cell.north, edge);
+    }
+
+    QGeoBoundingArea::AreaType m_type;
+    double m_top;
+    double m_bottom;
+    double m_left;
+    double m_right;
+    QGeoPreparedCircle m_circle;
+};
+
+static void qgeocellkey_cover(QGeoCellKeyScheme scheme, const QGeoCellKeyArea &area,
+                              int level, quint32 x, quint32 y, int maxLevel, QStringList *keys)
+{
+    QGeoCellKeyBounds bounds = qgeocellkey_bounds(scheme, level, x, y);
+    if (!area.intersects(bounds))
+        return;
+
+    if (level > 0 && (level == maxLevel || area.contains(bounds))) {
+        keys->append(qgeocellkey_toString(scheme, level,
+                                          qgeocellkey_interleave(scheme, level, x, y)));
+        return;
+    }
+
+    int xBits = qgeocellkey_longitudeBits(scheme, level + 1) - qgeocellkey_longitudeBits(scheme, level);
+    int yBits = qgeocellkey_latitudeBits(scheme, level + 1) - qgeocellkey_latitudeBits(scheme, level);
+    for (quint32 j = 0; j < (1u << yBits); ++j) {
+        for (quint32 i = 0; i < (1u << xBits); ++i)
+            qgeocellkey_cover(scheme, area, level + 1, (x << xBits) | i, (y << yBits) | j, maxLevel, keys);
+    }
+}
+
+static QStringList qgeocellkey_covering(QGeoCellKeyScheme scheme, const QGeoBoundingArea &area,
+                                        int level)
+{
+    QStringList keys;
+    if (!area.isValid() || level < 1)
+        return keys;
+
+    qgeocellkey_cover(scheme, QGeoCellKeyArea(area), 0, 0, 0, level, &keys);
+    return keys;
+}
+
+/*!
+    \class QGeoCellKey
+    \brief The QGeoCellKey class converts between coordinates and geohashes
+    or quadkeys.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeocellkey.cpp <QtLocationSubset/QGeoCellKey>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    Geohashes and quadkeys name the cells of a grid over the Earth, and
+    nearby coordinates mostly share a prefix of their keys. That makes them
+    suitable as keys for caches, shards and duplicate detection.
+
+    A geohash of \c n characters from the alphabet \c 0-9 and \c b-z
+    (without \c a, \c i, \c l and \c o) names a cell of 5\c n bits of
+    latitude and longitude, starting at 4.9 by 4.9 kilometres on the
+    equator for 5 characters and ending at 3.7 by 1.9 centimetres for 12.
+
+    A quadkey of \c n digits from 0 to 3 names the map tile of level \c n in
+    the Web Mercator tiling used by Bing Maps, and covers latitudes up to
+    85.05 degrees north and south; coordinates closer to the poles get the
+    key of the nearest tile.
+
+    geohashBits() and quadKeyBits() return the interleaved bits of a key as
+    a number, without formatting them as text, for keying large numbers of
+    coordinates. On processors with the BMI2 instructions the bits are
+    interleaved with PDEP and PEXT.
+*/
+
+/*!
+    Returns the 5 * \a precision bits of the geohash of the coordinate at
+    \a latitude and \a longitude, with the bits of the first character in
+    the most significant position. \a precision is limited to 1 to 12.
+
+    Returns 0 if the coordinate is invalid.
+*/
+quint64 QGeoCellKey::geohashBits(double latitude, double longitude, int precision)
+{
+    if (!QGeoCoordinateValue(latitude, longitude).isValid())
+        return 0;
+    precision = qBound(1, precision, qgeocellkey_MAX_GEOHASH_PRECISION);
+
+    quint32 x, y;
+    qgeocellkey_cell(QGeoCellKeyGeohash, precision, latitude, longitude, &x, &y);
+    return qgeocellkey_interleave(QGeoCellKeyGeohash, precision, x, y);
+}
+
+/*!
+    Returns the geohash of \a coordinate, \a precision characters long.
+    \a precision is limited to 1 to 12.
+
+    Returns an empty string if \a coordinate is invalid.
+*/
+QString QGeoCellKey::geohash(const QGeoCoordinate &coordinate, int precision)
+{
+    if (!coordinate.isValid())
+        return QString();
+    precision = qBound(1, precision, qgeocellkey_MAX_GEOHASH_PRECISION);
+
+    quint64 bits = geohashBits(coordinate.latitude(), coordinate.longitude(), precision);
+    return qgeocellkey_toString(QGeoCellKeyGeohash, precision, bits);
+}
+
+/*!
+    Returns the cell named by \a geohash, which may be in upper or lower
+    case.
+
+    Returns an invalid bounding box if \a geohash is not a geohash of 1 to
+    12 characters.
+*/
+QGeoBoundingBox QGeoCellKey::geohashBounds(const QString &geohash)
+{
+    quint32 x, y;
+    if (!qgeocellkey_fromString(QGeoCellKeyGeohash, geohash, &x, &y))
+        return QGeoBoundingBox();
+
+    QGeoCellKeyBounds bounds = qgeocellkey_bounds(QGeoCellKeyGeohash, geohash.length(), x, y);
+    return QGeoBoundingBox(QGeoCoordinate(bounds.north, bounds.west),
+                           QGeoCoordinate(bounds.south, bounds.east));
+}
+
+/*!
+    Returns the geohashes of the cells that together cover \a area, which
+    must be a QGeoBoundingBox or a QGeoBoundingCircle, using as few cells
+    as possible: a cell that lies within \a area is returned in place of its
+    subcells. No returned geohash is longer than \a precision characters.
+
+    The number of cells grows with the length of the area's outline
+    measured in cells of \a precision, so \a precision should fit the size
+    of \a area. A box with an edge at a pole is covered over its own
+    longitudes only, although it contains the pole at every longitude.
+*/
+QStringList QGeoCellKey::geohashCovering(const QGeoBoundingArea &area, int precision)
+{
+    return qgeocellkey_covering(QGeoCellKeyGeohash, area,
+                                qMin(precision, qgeocellkey_MAX_GEOHASH_PRECISION));
+}
+
+/*!
+    Returns the 2 * \a level bits of the quadkey of the coordinate at
+    \a latitude and \a longitude, with the bits of the first digit in the
+    most significant position. \a level is limited to 1 to 23.
+
+    Returns 0 if the coordinate is invalid.
+*/
+quint64 QGeoCellKey::quadKeyBits(double latitude, double longitude, int level)
+{
+    if (!QGeoCoordinateValue(latitude, longitude).isValid())
+        return 0;
+    level = qBound(1, level, qgeocellkey_MAX_QUADKEY_LEVEL);
+
+    quint32 x, y;
+    qgeocellkey_cell(QGeoCellKeyQuadKey, level, latitude, longitude, &x, &y);
+    return qgeocellkey_interleave(QGeoCellKeyQuadKey, level, x, y);
+}
+
+/*!
+    Returns the quadkey of the map tile of \a level that holds
+    \a coordinate. \a level is limited to 1 to 23.
+
+    Returns an empty string if \a coordinate is invalid.
+*/
+QString QGeoCellKey::quadKey(const QGeoCoordinate &coordinate, int level)
+{
+    if (!coordinate.isValid())
+        return QString();
+    level = qBound(1, level, qgeocellkey_MAX_QUADKEY_LEVEL);
+
+    quint64 bits = quadKeyBits(coordinate.latitude(), coordinate.longitude(), level);
+    return qgeocellkey_toString(QGeoCellKeyQuadKey, level, bits);
+}
+
+/*!
+    Returns the map tile named by \a quadKey.
+
+    Returns an invalid bounding box if \a quadKey is not a quadkey of 1 to
+    23 digits.
+*/
+QGeoBoundingBox QGeoCellKey::quadKeyBounds(const QString &quadKey)
+{
+    quint32 x, y;
+    if (!qgeocellkey_fromString(QGeoCellKeyQuadKey, quadKey, &x, &y))
+        return QGeoBoundingBox();
+
+    QGeoCellKeyBounds bounds = qgeocellkey_bounds(QGeoCellKeyQuadKey, quadKey.length(), x, y);
+    return QGeoBoundingBox(QGeoCoordinate(bounds.north, bounds.west),
+                           QGeoCoordinate(bounds.south, bounds.east));
+}
+
+/*!
+    Returns the quadkeys of the map tiles that together cover \a area, which
+    must be a QGeoBoundingBox or a QGeoBoundingCircle, using as few tiles as
+    possible, as geohashCovering() does. No returned quadkey is longer than
+    \a level digits.
+*/
+QStringList QGeoCellKey::quadKeyCovering(const QGeoBoundingArea &area, int level)
+{
+    return qgeocellkey_covering(QGeoCellKeyQuadKey, area,
+                                qMin(level, qgeocellkey_MAX_QUADKEY_LEVEL));
+}
+
+QTMS_END_NAMESPACE
@@ -39,9 +39,12 @@
 **
 ****************************************************************************/
 #include "qgeocoordinate.h"
+#include "qgeocoordinatevalue.h"
+#include "qgeocellkey.h"
 #include "qgeocoordinate_p.h"
 #include "qlocationutils_p.h"
 
+#include <QAtomicInt>
 #include <QDateTime>
 #include <QHash>
 #include <QDataStream>
@@ -58,8 +61,6 @@
 
 QTMS_BEGIN_NAMESPACE
 
-static const double qgeocoordinate_EARTH_MEAN_RADIUS = 6371.0072;
-
 inline static double qgeocoordinate_degToRad(double deg)
 {
     return deg * M_PI / 180;
@@ -70,12 +71,275 @@ inline static double qgeocoordinate_radToDeg(double rad)
 }
 
 
+static bool qgeocoordinate_equal(double lat1, double lng1, double alt1,
+                                 double lat2, double lng2, double alt2)
+{
+    bool latEqual = (qIsNaN(lat1) && qIsNaN(lat2))
+                        || qFuzzyCompare(lat1, lat2);
+    bool lngEqual = (qIsNaN(lng1) && qIsNaN(lng2))
+                        || qFuzzyCompare(lng1, lng2);
+    bool altEqual = (qIsNaN(alt1) && qIsNaN(alt2))
+                        || qFuzzyCompare(alt1, alt2);
+
+    if (!qIsNaN(lat1) && ((lat1 == 90.0) || (lat1 == -90.0)))
+        lngEqual = true;
+
+    return (latEqual && lngEqual && altEqual);
+}
+
+static QGeoCoordinate::CoordinateType qgeocoordinate_type(double lat, double lng, double alt)
+{
+    if (QLocationUtils::isValidLat(lat)
+            && QLocationUtils::isValidLong(lng)) {
+        if (qIsNaN(alt))
+            return QGeoCoordinate::Coordinate2D;
+        return QGeoCoordinate::Coordinate3D;
+    }
+    return QGeoCoordinate::InvalidCoordinate;
+}
+
+// WGS84 ellipsoid, in metres.
+static const double qgeocoordinate_WGS84_A = 6378137.0;
+static const double qgeocoordinate_WGS84_F = 1 / 298.257223563;
+static const double qgeocoordinate_WGS84_B = qgeocoordinate_WGS84_A * (1 - qgeocoordinate_WGS84_F);
+
+static QBasicAtomicInt qgeocoordinate_defaultDistanceMode
+        = Q_BASIC_ATOMIC_INITIALIZER(QGeoCoordinate::SphericalDistance);
+
+// Brings a longitude difference in degrees into [-180, 180].
+inline static double qgeocoordinate_wrapLongitude(double dlon)
+{
+    if (dlon > 180.0)
+        return dlon - 360.0;
+    if (dlon < -180.0)
+        return dlon + 360.0;
+    return dlon;
+}
+
+inline static double qgeocoordinate_normalizeAzimuth(double azimuth)
+{
+    double whole;
+    double fraction = modf(azimuth, &whole);
+    return (int(whole + 360) % 360) + fraction;
+}
+
+static double qgeocoordinate_haversineDistance(double lat1, double lng1, double lat2, double lng2)
+{
+    // Haversine formula
+    double dlat = qgeocoordinate_degToRad(lat2 - lat1);
+    double dlon = qgeocoordinate_degToRad(lng2 - lng1);
+    double haversine_dlat = sin(dlat / 2.0);
+    haversine_dlat *= haversine_dlat;
+    double haversine_dlon = sin(dlon / 2.0);
+    haversine_dlon *= haversine_dlon;
+    double y = haversine_dlat
+             + cos(qgeocoordinate_degToRad(lat1))
+             * cos(qgeocoordinate_degToRad(lat2))
+             * haversine_dlon;
+    double x = 2 * asin(sqrt(y));
+    return x * qgeocoordinate_EARTH_MEAN_RADIUS * 1000;
+}
+
+static double qgeocoordinate_greatCircleAzimuth(double lat1, double lng1, double lat2, double lng2)
+{
+    double dlon = qgeocoordinate_degToRad(lng2 - lng1);
+    double lat1Rad = qgeocoordinate_degToRad(lat1);
+    double lat2Rad = qgeocoordinate_degToRad(lat2);
+
+    double y = sin(dlon) * cos(lat2Rad);
+    double x = cos(lat1Rad) * sin(lat2Rad) - sin(lat1Rad) * cos(lat2Rad) * cos(dlon);
+
+    return qgeocoordinate_normalizeAzimuth(qgeocoordinate_radToDeg(atan2(y, x)));
+}
+
+// Projects both coordinates onto a plane through their mean latitude, which
+// is accurate to a fraction of a percent over a few tens of kilometres away
+// from the poles.
+static void qgeocoordinate_equirectangular(double lat1, double lng1, double lat2, double lng2,
+                                           double *distance, double *azimuth)
+{
+    double x = qgeocoordinate_degToRad(qgeocoordinate_wrapLongitude(lng2 - lng1))
+               * cos(qgeocoordinate_degToRad((lat1 + lat2) / 2));
+    double y = qgeocoordinate_degToRad(lat2 - lat1);
+
+    if (distance)
+        *distance = sqrt(x * x + y * y) * qgeocoordinate_EARTH_MEAN_RADIUS * 1000;
+    if (azimuth)
+        *azimuth = qgeocoordinate_normalizeAzimuth(qgeocoordinate_radToDeg(atan2(x, y)));
+}
+
 QGeoCoordinatePrivate::QGeoCoordinatePrivate() {
     lat = qQNaN();
     lng = qQNaN();
     alt = qQNaN();
 }
 
+// Vincenty's inverse solution on the WGS84 ellipsoid. Returns false if the
+// iteration does not converge, which only happens for nearly antipodal
+// points.
+static bool qgeocoordinate_vincentyInverse(double lat1, double lng1, double lat2, double lng2,
+                                           double *distance, double *azimuth)
+{
+    const double a = qgeocoordinate_WGS84_A;
+    const double b = qgeocoordinate_WGS84_B;
+    const double f = qgeocoordinate_WGS84_F;
+
+    double L = qgeocoordinate_degToRad(qgeocoordinate_wrapLongitude(lng2 - lng1));
+    double U1 = atan((1 - f) * tan(qgeocoordinate_degToRad(lat1)));
+    double U2 = atan((1 - f) * tan(qgeocoordinate_degToRad(lat2)));
+    double sinU1 = sin(U1);
+    double cosU1 = cos(U1);
+    double sinU2 = sin(U2);
+    double cosU2 = cos(U2);
+
+    double lambda = L;
+    double sinLambda = 0;
+    double cosLambda = 0;
+    double sinSigma = 0;
+    double cosSigma = 0;
+    double sigma = 0;
+    double cosSqAlpha = 0;
+    double cos2SigmaM = 0;
+
+    int iterations = 0;
+    for (;;) {
+        sinLambda = sin(lambda);
+        cosLambda = cos(lambda);
+        double t = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+        sinSigma = sqrt((cosU2 * sinLambda) * (cosU2 * sinLambda) + t * t);
+        if (sinSigma == 0) {
+            // coincident points
+            if (distance)
+                *distance = 0;
+            if (azimuth)
+                *azimuth = 0;
+            return true;
+        }
+        cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+        sigma = atan2(sinSigma, cosSigma);
+        double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+        cosSqAlpha = 1 - sinAlpha * sinAlpha;
+        // cosSqAlpha is 0 for points on the equator
+        cos2SigmaM = cosSqAlpha != 0 ? cosSigma - 2 * sinU1 * sinU2 / cosSqAlpha : 0;
+        double C = f / 16 * cosSqAlpha * (4 + f * (4 - 3 * cosSqAlpha));
+        double previous = lambda;
+        lambda = L + (1 - C) * f * sinAlpha
+                 * (sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+        if (fabs(lambda - previous) < 1e-12)
+            break;
+        if (++iterations == 200 || fabs(lambda) > M_PI)
+            return false;
+    }
+
+    double uSq = cosSqAlpha * (a * a - b * b) / (b * b);
+    double A = 1 + uSq / 16384 * (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+    double B = uSq / 1024 * (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+    double deltaSigma = B * sinSigma
+                        * (cos2SigmaM + B / 4 * (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)
+                                                 - B / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma)
+                                                   * (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+
+    if (distance)
+        *distance = b * A * (sigma - deltaSigma);
+    if (azimuth) {
+        double alpha1 = atan2(cosU2 * sinLambda, cosU1 * sinU2 - sinU1 * cosU2 * cosLambda);
+        *azimuth = qgeocoordinate_normalizeAzimuth(qgeocoordinate_radToDeg(alpha1));
+    }
+    return true;
+}
+
+// Vincenty's direct solution on the WGS84 ellipsoid. The longitude is not
+// brought back into [-180, 180].
+static void qgeocoordinate_vincentyDirect(double latitude, double longitude,
+                                          double distance, double azimuth,
+                                          double *lon, double *lat)
+{
+    const double a = qgeocoordinate_WGS84_A;
+    const double b = qgeocoordinate_WGS84_B;
+    const double f = qgeocoordinate_WGS84_F;
+
+    double alpha1 = qgeocoordinate_degToRad(azimuth);
+    double sinAlpha1 = sin(alpha1);
+    double cosAlpha1 = cos(alpha1);
+
+    double tanU1 = (1 - f) * tan(qgeocoordinate_degToRad(latitude));
+    double cosU1 = 1 / sqrt(1 + tanU1 * tanU1);
+    double sinU1 = tanU1 * cosU1;
+    double sigma1 = atan2(tanU1, cosAlpha1);
+    double sinAlpha = cosU1 * sinAlpha1;
+    double cosSqAlpha = 1 - sinAlpha * sinAlpha;
+    double uSq = cosSqAlpha * (a * a - b * b) / (b * b);
+    double A = 1 + uSq / 16384 * (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+    double B = uSq / 1024 * (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+
+    double sigma = distance / (b * A);
+    double sinSigma = 0;
+    double cosSigma = 0;
+    double cos2SigmaM = 0;
+    for (int i = 0; i < 100; ++i) {
+        cos2SigmaM = cos(2 * sigma1 + sigma);
+        sinSigma = sin(sigma);
+        cosSigma = cos(sigma);
+        double deltaSigma = B * sinSigma
+                            * (cos2SigmaM + B / 4 * (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)
+                                                     - B / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma)
+                                                       * (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+        double previous = sigma;
+        sigma = distance / (b * A) + deltaSigma;
+        if (fabs(sigma - previous) < 1e-12)
+            break;
+    }
+    sinSigma = sin(sigma);
+    cosSigma = cos(sigma);
+    cos2SigmaM = cos(2 * sigma1 + sigma);
+
+    double t = sinU1 * sinSigma - cosU1 * cosSigma * cosAlpha1;
+    double lat2 = atan2(sinU1 * cosSigma + cosU1 * sinSigma * cosAlpha1,
+                        (1 - f) * sqrt(sinAlpha * sinAlpha + t * t));
+    double lambda = atan2(sinSigma * sinAlpha1, cosU1 * cosSigma - sinU1 * sinSigma * cosAlpha1);
+    double C = f / 16 * cosSqAlpha * (4 + f * (4 - 3 * cosSqAlpha));
+    double L = lambda - (1 - C) * f * sinAlpha
+               * (sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+
+    *lat = qgeocoordinate_radToDeg(lat2);
+    *lon = longitude + qgeocoordinate_radToDeg(L);
+}
+
+static double qgeocoordinate_distance(double lat1, double lng1, double lat2, double lng2,
+                                      QGeoCoordinate::DistanceMode mode)
+{
+    double distance;
+    switch (mode) {
+    case QGeoCoordinate::EquirectangularDistance:
+        qgeocoordinate_equirectangular(lat1, lng1, lat2, lng2, &distance, 0);
+        return distance;
+    case QGeoCoordinate::EllipsoidalDistance:
+        if (qgeocoordinate_vincentyInverse(lat1, lng1, lat2, lng2, &distance, 0))
+            return distance;
+        break;
+    case QGeoCoordinate::SphericalDistance:
+        break;
+    }
+    return qgeocoordinate_haversineDistance(lat1, lng1, lat2, lng2);
+}
+
+static double qgeocoordinate_azimuth(double lat1, double lng1, double lat2, double lng2,
+                                     QGeoCoordinate::DistanceMode mode)
+{
+    double azimuth;
+    switch (mode) {
+    case QGeoCoordinate::EquirectangularDistance:
+        qgeocoordinate_equirectangular(lat1, lng1, lat2, lng2, 0, &azimuth);
+        return azimuth;
+    case QGeoCoordinate::EllipsoidalDistance:
+        if (qgeocoordinate_vincentyInverse(lat1, lng1, lat2, lng2, 0, &azimuth))
+            return azimuth;
+        break;
+    case QGeoCoordinate::SphericalDistance:
+        break;
+    }
+    return qgeocoordinate_greatCircleAzimuth(lat1, lng1, lat2, lng2);
+}
 
 /*!
     \class QGeoCoordinate
@@ -123,6 +387,30 @@ QGeoCoordinatePrivate::QGeoCoordinatePrivate() {
     \sa toString()
 */
 
+/*!
+    \enum QGeoCoordinate::DistanceMode
+    Defines how distanceTo(), azimuthTo() and atDistanceAndAzimuth() model
+    the Earth, trading accuracy for speed.
+
+    \value SphericalDistance The Earth is a sphere with the mean radius, and
+    the path between coordinates is a great-circle. The error is up to 0.5%
+    of the distance, depending on where and in which direction it is
+    measured.
+    \value EquirectangularDistance The coordinates are projected onto a plane
+    through their mean latitude, which saves most of the trigonometry of
+    SphericalDistance. It is as accurate as SphericalDistance over a few tens
+    of kilometres, but should not be used for longer distances or near the
+    poles.
+    \value EllipsoidalDistance The Earth is the WGS84 ellipsoid, and the path
+    is a geodesic found with Vincenty's formulae, accurate to within a
+    millimetre. This is several times as expensive as SphericalDistance. For
+    nearly antipodal coordinates, for which the formulae do not converge,
+    distanceTo() and azimuthTo() fall back to SphericalDistance.
+
+    \since 1.2
+    \sa setDefaultDistanceMode()
+*/
+
 
 /*!
     Constructs a coordinate. The coordinate will be invalid until
@@ -214,17 +502,7 @@ QGeoCoordinate &QGeoCoordinate::operator=(const QGeoCoordinate & other)
 */
 bool QGeoCoordinate::operator==(const QGeoCoordinate &other) const
 {
-    bool latEqual = (qIsNaN(d->lat) && qIsNaN(other.d->lat))
-                        || qFuzzyCompare(d->lat, other.d->lat);
-    bool lngEqual = (qIsNaN(d->lng) && qIsNaN(other.d->lng))
-                        || qFuzzyCompare(d->lng, other.d->lng);
-    bool altEqual = (qIsNaN(d->alt) && qIsNaN(other.d->alt))
-                        || qFuzzyCompare(d->alt, other.d->alt);
-
-    if (!qIsNaN(d->lat) && ((d->lat == 90.0) || (d->lat == -90.0)))
-        lngEqual = true;
-
-    return (latEqual && lngEqual && altEqual);
+    return qgeocoordinate_equal(d->lat, d->lng, d->alt, other.d->lat, other.d->lng, other.d->alt);
 }
 
 /*!
@@ -248,13 +526,7 @@ bool QGeoCoordinate::isValid() const
 */
 QGeoCoordinate::CoordinateType QGeoCoordinate::type() const
 {
-    if (QLocationUtils::isValidLat(d->lat)
-            && QLocationUtils::isValidLong(d->lng)) {
-        if (qIsNaN(d->alt))
-            return Coordinate2D;
-        return Coordinate3D;
-    }
-    return InvalidCoordinate;
+    return qgeocoordinate_type(d->lat, d->lng, d->alt);
 }
 
 
@@ -338,33 +610,38 @@ void QGeoCoordinate::setAltitude(double altitude)
     Returns the distance (in meters) from this coordinate to the coordinate
     specified by \a other. Altitude is not used in the calculation.
 
-    This calculation returns the great-circle distance between the two
-    coordinates, with an assumption that the Earth is spherical for the
-    purpose of this calculation.
+    This calculation returns the distance between the two coordinates in
+    the defaultDistanceMode(). Unless it has been changed, that is the
+    great-circle distance, with an assumption that the Earth is spherical
+    for the purpose of this calculation.
 
     Returns 0 if the type of this coordinate or the type of \a other is
     QGeoCoordinate::InvalidCoordinate.
 */
 qreal QGeoCoordinate::distanceTo(const QGeoCoordinate &other) const
+{
+    return distanceTo(other, defaultDistanceMode());
+}
+
+/*!
+    Returns the distance (in meters) from this coordinate to the coordinate
+    specified by \a other, calculated in the given \a mode. Altitude is not
+    used in the calculation.
+
+    Returns 0 if the type of this coordinate or the type of \a other is
+    QGeoCoordinate::InvalidCoordinate.
+
+    \since 1.2
+    \sa DistanceMode
+*/
+qreal QGeoCoordinate::distanceTo(const QGeoCoordinate &other, DistanceMode mode) const
 {
     if (type() == QGeoCoordinate::InvalidCoordinate
             || other.type() == QGeoCoordinate::InvalidCoordinate) {
         return 0;
     }
 
-    // Haversine formula
-    double dlat = qgeocoordinate_degToRad(other.d->lat - d->lat);
-    double dlon = qgeocoordinate_degToRad(other.d->lng - d->lng);
-    double haversine_dlat = sin(dlat / 2.0);
-    haversine_dlat *= haversine_dlat;
-    double haversine_dlon = sin(dlon / 2.0);
-    haversine_dlon *= haversine_dlon;
-    double y = haversine_dlat
-             + cos(qgeocoordinate_degToRad(d->lat))
-             * cos(qgeocoordinate_degToRad(other.d->lat))
-             * haversine_dlon;
-    double x = 2 * asin(sqrt(y));
-    return qreal(x * qgeocoordinate_EARTH_MEAN_RADIUS * 1000);
+    return qreal(qgeocoordinate_distance(d->lat, d->lng, other.d->lat, other.d->lng, mode));
 }
 
 /*!
@@ -372,43 +649,65 @@ qreal QGeoCoordinate::distanceTo(const QGeoCoordinate &other) const
     coordinate specified by \a other. Altitude is not used in the calculation.
 
     The bearing returned is the bearing from the origin to \a other along the
-    great-circle between the two coordinates. There is an assumption that the
-    Earth is spherical for the purpose of this calculation.
+    shortest path between the two coordinates in the defaultDistanceMode().
+    Unless it has been changed, that is the great-circle, with an assumption
+    that the Earth is spherical for the purpose of this calculation.
 
     Returns 0 if the type of this coordinate or the type of \a other is
     QGeoCoordinate::InvalidCoordinate.
 */
 qreal QGeoCoordinate::azimuthTo(const QGeoCoordinate &other) const
+{
+    return azimuthTo(other, defaultDistanceMode());
+}
+
+/*!
+    Returns the azimuth (or bearing) in degrees from this coordinate to the
+    coordinate specified by \a other, calculated in the given \a mode.
+    Altitude is not used in the calculation.
+
+    Returns 0 if the type of this coordinate or the type of \a other is
+    QGeoCoordinate::InvalidCoordinate.
+
+    \since 1.2
+    \sa DistanceMode
+*/
+qreal QGeoCoordinate::azimuthTo(const QGeoCoordinate &other, DistanceMode mode) const
 {
     if (type() == QGeoCoordinate::InvalidCoordinate
             || other.type() == QGeoCoordinate::InvalidCoordinate) {
         return 0;
     }
 
-    double dlon = qgeocoordinate_degToRad(other.d->lng - d->lng);
-    double lat1Rad = qgeocoordinate_degToRad(d->lat);
-    double lat2Rad = qgeocoordinate_degToRad(other.d->lat);
-
-    double y = sin(dlon) * cos(lat2Rad);
-    double x = cos(lat1Rad) * sin(lat2Rad) - sin(lat1Rad) * cos(lat2Rad) * cos(dlon);
-
-    double whole;
-    double fraction = modf(qgeocoordinate_radToDeg(atan2(y, x)), &whole);
-    return qreal((int(whole + 360) % 360) + fraction);
+    return qreal(qgeocoordinate_azimuth(d->lat, d->lng, other.d->lat, other.d->lng, mode));
 }
 
-void QGeoCoordinatePrivate::atDistanceAndAzimuth(const QGeoCoordinate &coord,
+void QGeoCoordinatePrivate::atDistanceAndAzimuth(double latitude, double longitude,
                                                  qreal distance, qreal azimuth,
+                                                 QGeoCoordinate::DistanceMode mode,
                                                  double *lon, double *lat)
 {
-    double latRad = qgeocoordinate_degToRad(coord.d->lat);
-    double lonRad = qgeocoordinate_degToRad(coord.d->lng);
+    if (mode == QGeoCoordinate::EllipsoidalDistance) {
+        qgeocoordinate_vincentyDirect(latitude, longitude, distance, azimuth, lon, lat);
+        return;
+    }
+
+    double latRad = qgeocoordinate_degToRad(latitude);
+    double lonRad = qgeocoordinate_degToRad(longitude);
     double cosLatRad = cos(latRad);
     double sinLatRad = sin(latRad);
 
     double azimuthRad = qgeocoordinate_degToRad(azimuth);
 
     double ratio = (distance / (qgeocoordinate_EARTH_MEAN_RADIUS * 1000.0));
+
+    if (mode == QGeoCoordinate::EquirectangularDistance) {
+        double resultLat = qgeocoordinate_radToDeg(latRad + ratio * cos(azimuthRad));
+        *lat = qBound(-90.0, resultLat, 90.0);
+        *lon = qgeocoordinate_radToDeg(lonRad + ratio * sin(azimuthRad) / cosLatRad);
+        return;
+    }
+
     double cosRatio = cos(ratio);
     double sinRatio = sin(ratio);
 
@@ -424,21 +723,40 @@ void QGeoCoordinatePrivate::atDistanceAndAzimuth(const QGeoCoordinate &coord,
 
 /*!
     Returns the coordinate that is reached by traveling \a distance meters
-    from the current coordinate at \a azimuth (or bearing) along a great-circle.
-    There is an assumption that the Earth is spherical for the purpose of this
-    calculation.
+    from the current coordinate at \a azimuth (or bearing) along the
+    shortest path in the defaultDistanceMode(). Unless that has been
+    changed, the path is a great-circle, with an assumption that the Earth
+    is spherical for the purpose of this calculation.
 
     The altitude will have \a distanceUp added to it.
 
     Returns an invalid coordinate if this coordinate is invalid.
 */
 QGeoCoordinate QGeoCoordinate::atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp) const
+{
+    return atDistanceAndAzimuth(distance, azimuth, distanceUp, defaultDistanceMode());
+}
+
+/*!
+    Returns the coordinate that is reached by traveling \a distance meters
+    from the current coordinate at \a azimuth (or bearing), calculated in
+    the given \a mode.
+
+    The altitude will have \a distanceUp added to it.
+
+    Returns an invalid coordinate if this coordinate is invalid.
+
+    \since 1.2
+    \sa DistanceMode
+*/
+QGeoCoordinate QGeoCoordinate::atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp,
+                                                    DistanceMode mode) const
 {
     if (!isValid())
         return QGeoCoordinate();
 
     double resultLon, resultLat;
-    QGeoCoordinatePrivate::atDistanceAndAzimuth(*this, distance, azimuth,
+    QGeoCoordinatePrivate::atDistanceAndAzimuth(d->lat, d->lng, distance, azimuth, mode,
                                                 &resultLon, &resultLat);
 
     if (resultLon > 180.0)
@@ -450,6 +768,36 @@ QGeoCoordinate QGeoCoordinate::atDistanceAndAzimuth(qreal distance, qreal azimut
     return QGeoCoordinate(resultLat, resultLon, resultAlt);
 }
 
+/*!
+    Sets the mode in which distanceTo(), azimuthTo() and
+    atDistanceAndAzimuth() calculate, when they are not given one, to
+    \a mode. This applies to QGeoCoordinateValue as well, and to all
+    threads.
+
+    The default is QGeoCoordinate::SphericalDistance. QGeoBoundingCircle,
+    QGeoPreparedCircle and QGeoCoordinateBatch always calculate on the
+    sphere.
+
+    \since 1.2
+    \sa defaultDistanceMode()
+*/
+void QGeoCoordinate::setDefaultDistanceMode(DistanceMode mode)
+{
+    qgeocoordinate_defaultDistanceMode.fetchAndStoreRelaxed(mode);
+}
+
+/*!
+    Returns the mode in which distanceTo(), azimuthTo() and
+    atDistanceAndAzimuth() calculate when they are not given one.
+
+    \since 1.2
+    \sa setDefaultDistanceMode()
+*/
+QGeoCoordinate::DistanceMode QGeoCoordinate::defaultDistanceMode()
+{
+    return DistanceMode(int(qgeocoordinate_defaultDistanceMode));
+}
+
 /*!
     Returns this coordinate as a string in the specified \a format.
 
@@ -570,6 +918,284 @@ QString QGeoCoordinate::toString(CoordinateFormat format) const
     return QString("%1, %2, %3m").arg(latStr, longStr, QString::number(d->alt));
 }
 
+/*!
+    Returns the geohash of this coordinate, \a precision characters long.
+
+    \since 1.2
+    \sa fromGeohash(), QGeoCellKey::geohash()
+*/
+QString QGeoCoordinate::toGeohash(int precision) const
+{
+    return QGeoCellKey::geohash(*this, precision);
+}
+
+/*!
+    Returns the center of the cell named by \a geohash, or an invalid
+    coordinate if \a geohash is not a geohash.
+
+    \since 1.2
+    \sa toGeohash(), QGeoCellKey::geohashBounds()
+*/
+QGeoCoordinate QGeoCoordinate::fromGeohash(const QString &geohash)
+{
+    QGeoBoundingBox bounds = QGeoCellKey::geohashBounds(geohash);
+    return bounds.isValid() ? bounds.center() : QGeoCoordinate();
+}
+
+/*!
+    Returns the quadkey of the map tile of \a level that holds this
+    coordinate.
+
+    \since 1.2
+    \sa fromQuadKey(), QGeoCellKey::quadKey()
+*/
+QString QGeoCoordinate::toQuadKey(int level) const
+{
+    return QGeoCellKey::quadKey(*this, level);
+}
+
+/*!
+    Returns the center of the map tile named by \a quadKey, or an invalid
+    coordinate if \a quadKey is not a quadkey.
+
+    \since 1.2
+    \sa toQuadKey(), QGeoCellKey::quadKeyBounds()
+*/
+QGeoCoordinate QGeoCoordinate::fromQuadKey(const QString &quadKey)
+{
+    QGeoBoundingBox bounds = QGeoCellKey::quadKeyBounds(quadKey);
+    return bounds.isValid() ? bounds.center() : QGeoCoordinate();
+}
+
+/*!
+    \class QGeoCoordinateValue
+    \brief The QGeoCoordinateValue class holds a geographical position in place, without allocating memory.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeocoordinate.cpp <QtLocationSubset/QGeoCoordinateValue>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    A QGeoCoordinate allocates its latitude, longitude and altitude on the
+    heap, once for every construction and copy. QGeoCoordinateValue stores
+    them in the object itself, so creating, copying and destroying one costs
+    no more than copying three doubles, and a QVector of them is one
+    contiguous block. It behaves like QGeoCoordinate, and converts from and
+    to it with QGeoCoordinateValue(const QGeoCoordinate &) and
+    toCoordinate().
+
+    Use it for coordinates that are created or copied in large numbers, such
+    as those of search results or of a track.
+
+    \sa QGeoCoordinate
+*/
+
+/*!
+    \fn QGeoCoordinateValue::QGeoCoordinateValue()
+
+    Constructs a coordinate. The coordinate will be invalid until
+    setLatitude() and setLongitude() have been called.
+*/
+
+/*!
+    \fn QGeoCoordinateValue::QGeoCoordinateValue(double latitude, double longitude)
+
+    Constructs a coordinate with the given \a latitude and \a longitude.
+
+    As for QGeoCoordinate, if the latitude is not between -90 to 90
+    inclusive, or the longitude is not between -180 to 180 inclusive, none
+    of the values are set and the coordinate is invalid.
+*/
+
+/*!
+    \fn QGeoCoordinateValue::QGeoCoordinateValue(double latitude, double longitude, double altitude)
+
+    Constructs a coordinate with the given \a latitude, \a longitude and
+    \a altitude.
+
+    As for QGeoCoordinate, if the latitude is not between -90 to 90
+    inclusive, or the longitude is not between -180 to 180 inclusive, none
+    of the values are set and the coordinate is invalid.
+*/
+
+/*!
+    Constructs a copy of \a coordinate.
+*/
+QGeoCoordinateValue::QGeoCoordinateValue(const QGeoCoordinate &coordinate)
+        : m_latitude(coordinate.latitude()),
+        m_longitude(coordinate.longitude()),
+        m_altitude(coordinate.altitude())
+{
+}
+
+/*!
+    Returns this coordinate as a QGeoCoordinate.
+*/
+QGeoCoordinate QGeoCoordinateValue::toCoordinate() const
+{
+    QGeoCoordinate coordinate;
+    coordinate.setLatitude(m_latitude);
+    coordinate.setLongitude(m_longitude);
+    coordinate.setAltitude(m_altitude);
+    return coordinate;
+}
+
+/*!
+    Returns true if the latitude, longitude and altitude of this
+    coordinate are the same as those of \a other.
+
+    The longitude will be ignored if the latitude is +/- 90 degrees.
+*/
+bool QGeoCoordinateValue::operator==(const QGeoCoordinateValue &other) const
+{
+    return qgeocoordinate_equal(m_latitude, m_longitude, m_altitude,
+                                other.m_latitude, other.m_longitude, other.m_altitude);
+}
+
+/*!
+    \fn bool QGeoCoordinateValue::operator!=(const QGeoCoordinateValue &other) const;
+
+    Returns true if the latitude, longitude or altitude of this
+    coordinate are not the same as those of \a other.
+*/
+
+/*!
+    Returns true if the type() is QGeoCoordinate::Coordinate2D or
+    QGeoCoordinate::Coordinate3D.
+*/
+bool QGeoCoordinateValue::isValid() const
+{
+    return qgeocoordinate_type(m_latitude, m_longitude, m_altitude) != QGeoCoordinate::InvalidCoordinate;
+}
+
+/*!
+    Returns the type of this coordinate.
+*/
+QGeoCoordinate::CoordinateType QGeoCoordinateValue::type() const
+{
+    return qgeocoordinate_type(m_latitude, m_longitude, m_altitude);
+}
+
+/*!
+    \fn void QGeoCoordinateValue::setLatitude(double latitude)
+
+    Sets the latitude (in decimal degrees) to \a latitude.
+*/
+
+/*!
+    \fn double QGeoCoordinateValue::latitude() const
+
+    Returns the latitude, in decimal degrees.
+*/
+
+/*!
+    \fn void QGeoCoordinateValue::setLongitude(double longitude)
+
+    Sets the longitude (in decimal degrees) to \a longitude.
+*/
+
+/*!
+    \fn double QGeoCoordinateValue::longitude() const
+
+    Returns the longitude, in decimal degrees.
+*/
+
+/*!
+    \fn void QGeoCoordinateValue::setAltitude(double altitude)
+
+    Sets the altitude (meters above sea level) to \a altitude.
+*/
+
+/*!
+    \fn double QGeoCoordinateValue::altitude() const
+
+    Returns the altitude (meters above sea level).
+*/
+
+/*!
+    Returns the distance (in meters) from this coordinate to the coordinate
+    specified by \a other, like QGeoCoordinate::distanceTo().
+*/
+qreal QGeoCoordinateValue::distanceTo(const QGeoCoordinateValue &other) const
+{
+    return distanceTo(other, QGeoCoordinate::defaultDistanceMode());
+}
+
+/*!
+    Returns the distance (in meters) from this coordinate to the coordinate
+    specified by \a other, calculated in the given \a mode.
+*/
+qreal QGeoCoordinateValue::distanceTo(const QGeoCoordinateValue &other,
+                                      QGeoCoordinate::DistanceMode mode) const
+{
+    if (!isValid() || !other.isValid())
+        return 0;
+
+    return qreal(qgeocoordinate_distance(m_latitude, m_longitude,
+                                         other.m_latitude, other.m_longitude, mode));
+}
+
+/*!
+    Returns the azimuth (or bearing) in degrees from this coordinate to the
+    coordinate specified by \a other, like QGeoCoordinate::azimuthTo().
+*/
+qreal QGeoCoordinateValue::azimuthTo(const QGeoCoordinateValue &other) const
+{
+    return azimuthTo(other, QGeoCoordinate::defaultDistanceMode());
+}
+
+/*!
+    Returns the azimuth (or bearing) in degrees from this coordinate to the
+    coordinate specified by \a other, calculated in the given \a mode.
+*/
+qreal QGeoCoordinateValue::azimuthTo(const QGeoCoordinateValue &other,
+                                     QGeoCoordinate::DistanceMode mode) const
+{
+    if (!isValid() || !other.isValid())
+        return 0;
+
+    return qreal(qgeocoordinate_azimuth(m_latitude, m_longitude,
+                                        other.m_latitude, other.m_longitude, mode));
+}
+
+/*!
+    Returns the coordinate that is reached by traveling \a distance meters
+    from the current coordinate at \a azimuth (or bearing), like
+    QGeoCoordinate::atDistanceAndAzimuth(). The altitude will have
+    \a distanceUp added to it.
+*/
+QGeoCoordinateValue QGeoCoordinateValue::atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp) const
+{
+    return atDistanceAndAzimuth(distance, azimuth, distanceUp, QGeoCoordinate::defaultDistanceMode());
+}
+
+/*!
+    Returns the coordinate that is reached by traveling \a distance meters
+    from the current coordinate at \a azimuth (or bearing), calculated in
+    the given \a mode. The altitude will have \a distanceUp added to it.
+*/
+QGeoCoordinateValue QGeoCoordinateValue::atDistanceAndAzimuth(qreal distance, qreal azimuth, qreal distanceUp,
+                                                              QGeoCoordinate::DistanceMode mode) const
+{
+    if (!isValid())
+        return QGeoCoordinateValue();
+
+    double resultLon, resultLat;
+    QGeoCoordinatePrivate::atDistanceAndAzimuth(m_latitude, m_longitude, distance, azimuth, mode,
+                                                &resultLon, &resultLat);
+
+    if (resultLon > 180.0)
+        resultLon -= 360.0;
+    else if (resultLon < -180.0)
+        resultLon += 360.0;
+
+    return QGeoCoordinateValue(resultLat, resultLon, m_altitude + distanceUp);
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 QDebug operator<<(QDebug dbg, const QGeoCoordinate &coord)
 {
@@ -58,6 +58,9 @@
 
 QTMS_BEGIN_NAMESPACE
 
+// In kilometres.
+static const double qgeocoordinate_EARTH_MEAN_RADIUS = 6371.0072;
+
 class QGeoCoordinatePrivate
 {
 public:
@@ -67,8 +70,9 @@ public:
     double lng;
     double alt;
 
-    static void atDistanceAndAzimuth(const QGeoCoordinate &coord,
+    static void atDistanceAndAzimuth(double latitude, double longitude,
                                      qreal distance, qreal azimuth,
+                                     QGeoCoordinate::DistanceMode mode,
                                      double *lon, double *lat);
 };
 
@@ -170,7 +170,7 @@ void QGeoPlace::setViewport(const QGeoBoundingBox &viewport)
 QGeoCoordinate QGeoPlace::coordinate() const
 {
     Q_D(const QGeoPlace);
-    return d->coordinate;
+    return d->coordinate.toCoordinate();
 }
 
 /*!
@@ -59,7 +59,7 @@
 #include "qgeoplace.h"
 #include "qgeoaddress.h"
 #include "qgeoboundingbox.h"
-#include "qgeocoordinate.h"
+#include "qgeocoordinatevalue.h"
 
 QTMS_BEGIN_NAMESPACE
 
@@ -77,7 +77,7 @@ public:
 
     virtual QGeoPlacePrivate* clone() const { return new QGeoPlacePrivate(*this); }
     QGeoBoundingBox viewport;
-    QGeoCoordinate coordinate;
+    QGeoCoordinateValue coordinate;
     QGeoAddress address;
 };
 
@@ -0,0 +1,434 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qgeopositionhub_p.h"
+#include "qgeopositioninfosource.h"
+
+#include <qnumeric.h>
+
+QTMS_BEGIN_NAMESPACE
+
+// Orders the loads before it against the loads and stores after it.
+static inline void acquireBarrier()
+{
+#if defined(Q_CC_GNU) && (defined(__i386__) || defined(__x86_64__))
+    // x86 does not reorder loads with other loads or with later stores
+    asm volatile("" ::: "memory");
+#elif defined(Q_CC_GNU) && (defined(__ARM_ARCH_7__) || defined(__ARM_ARCH_7A__))
+    asm volatile("dmb" ::: "memory");
+#elif defined(Q_CC_GNU)
+    __sync_synchronize();
+#else
+    QAtomicInt fence;
+    fence.fetchAndAddOrdered(0);
+#endif
+}
+
+// Reads the value without the read-modify-write of fetchAndAddAcquire(0),
+// so that many readers do not take the cache line of the counter from
+// the writer and from each other.
+static inline int loadAcquire(const QAtomicInt &value)
+{
+    int result = value._q_value;
+    acquireBarrier();
+    return result;
+}
+
+QGeoPositionHubPrivate::QGeoPositionHubPrivate(int capacity)
+        : mask(0),
+        published(0)
+{
+    // a power of two, so that the slot of a fix is its number masked
+    uint size = 2;
+    while (size < uint(capacity) && size < (1u << 20))
+        size <<= 1;
+
+    ring = new QGeoPositionHubSlot[size];
+    mask = size - 1;
+}
+
+QGeoPositionHubPrivate::~QGeoPositionHubPrivate()
+{
+    delete [] ring;
+}
+
+// Copies the fix with the given number, returns false if it has been overwritten.
+bool QGeoPositionHubPrivate::readSlot(uint index, QGeoPositionFix *fix)
+{
+    QGeoPositionHubSlot &slot = ring[index & mask];
+    int complete = int(index * 2 + 2);
+    if (loadAcquire(slot.sequence) != complete)
+        return false;
+
+    *fix = slot.fix;
+    // the copy must be read before the sequence is checked again
+    acquireBarrier();
+    return slot.sequence._q_value == complete;
+}
+
+/*!
+    \class QGeoPositionHub
+    \brief The QGeoPositionHub class distributes position updates to readers in many threads without copying QGeoPositionInfo objects.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeopositionhub.cpp <QtLocationSubset/QGeoPositionHub>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    Connecting many receivers in other threads to
+    QGeoPositionInfoSource::positionUpdated() copies the QGeoPositionInfo for
+    every queued connection. A QGeoPositionHub instead stores each update as
+    a plain QGeoPositionFix record in a ring of capacity() records, and any
+    number of QGeoPositionHubReader objects read the records from their own
+    threads. Neither publishing nor reading takes a lock or allocates memory.
+
+    The updates of a source set with setSource() are published in the
+    thread of the source. Fixes can also be published with publish(), but
+    from a single thread at a time.
+
+    \code
+    QGeoPositionHub *hub = new QGeoPositionHub;
+    hub->setSource(QGeoPositionInfoSource::createDefaultSource(hub));
+    hub->source()->startUpdates();
+
+    // in a worker thread, e.g. once per frame
+    QGeoPositionFix fix;
+    while (reader->read(&fix))
+        process(fix);
+    \endcode
+
+    Readers poll the hub; a reader that falls more than capacity() fixes
+    behind loses the oldest ones, see QGeoPositionHubReader::lostCount().
+
+    \sa QGeoPositionHubReader
+*/
+
+/*!
+    \class QGeoPositionFix
+    \brief The QGeoPositionFix struct is a plain copy of a QGeoPositionInfo.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeopositionhub.cpp <QtLocationSubset/QGeoPositionHub>
+
+    Values that are not known are NaN, except for the timestamp, which is -1.
+
+    \sa QGeoPositionHub::toFix(), QGeoPositionHub::toPositionInfo()
+*/
+
+/*!
+    \variable QGeoPositionFix::timestamp
+    The time of the fix in milliseconds since 1970-01-01T00:00:00 UTC.
+*/
+
+/*!
+    \variable QGeoPositionFix::latitude
+    The latitude in decimal degrees.
+*/
+
+/*!
+    \variable QGeoPositionFix::longitude
+    The longitude in decimal degrees.
+*/
+
+/*!
+    \variable QGeoPositionFix::altitude
+    The altitude in meters above sea level.
+*/
+
+/*!
+    \variable QGeoPositionFix::attributes
+    The attributes of the fix, indexed by QGeoPositionInfo::Attribute.
+*/
+
+/*!
+    Constructs a hub with the given \a parent that keeps the last
+    \a capacity fixes. The capacity is rounded up to a power of two.
+*/
+QGeoPositionHub::QGeoPositionHub(int capacity, QObject *parent)
+        : QObject(parent),
+        d(new QGeoPositionHubPrivate(capacity))
+{
+}
+
+/*!
+    Destroys the hub. The readers of the hub must not be used afterwards.
+*/
+QGeoPositionHub::~QGeoPositionHub()
+{
+    delete d;
+}
+
+/*!
+    Returns the number of fixes that the hub keeps for readers that fall
+    behind.
+*/
+int QGeoPositionHub::capacity() const
+{
+    return int(d->mask + 1);
+}
+
+/*!
+    Publishes the position updates of \a source. The updates are published
+    from the thread of the source, through a direct connection.
+
+    The hub does not take ownership of the source.
+*/
+void QGeoPositionHub::setSource(QGeoPositionInfoSource *source)
+{
+    if (d->source == source)
+        return;
+
+    if (d->source)
+        disconnect(d->source, SIGNAL(positionUpdated(QGeoPositionInfo)), this, SLOT(publish(QGeoPositionInfo)));
+
+    d->source = source;
+    if (source) {
+        connect(source, SIGNAL(positionUpdated(QGeoPositionInfo)), this, SLOT(publish(QGeoPositionInfo)),
+                Qt::DirectConnection);
+    }
+}
+
+/*!
+    Returns the source whose updates are published, or 0 if no source has
+    been set.
+*/
+QGeoPositionInfoSource *QGeoPositionHub::source() const
+{
+    return d->source;
+}
+
+/*!
+    Publishes \a info to the readers of the hub.
+*/
+void QGeoPositionHub::publish(const QGeoPositionInfo &info)
+{
+    publish(toFix(info));
+}
+
+/*!
+    Publishes \a fix to the readers of the hub.
+
+    Only one thread may publish at a time.
+*/
+void QGeoPositionHub::publish(const QGeoPositionFix &fix)
+{
+    // only this thread writes to published
+    uint index = uint(int(d->published));
+    QGeoPositionHubSlot &slot = d->ring[index & d->mask];
+
+    slot.sequence.fetchAndStoreOrdered(int(index * 2 + 1));
+    slot.fix = fix;
+    slot.sequence.fetchAndStoreRelease(int(index * 2 + 2));
+
+    d->published.fetchAndStoreRelease(int(index + 1));
+}
+
+/*!
+    Returns \a info as a QGeoPositionFix.
+*/
+QGeoPositionFix QGeoPositionHub::toFix(const QGeoPositionInfo &info)
+{
+    QGeoPositionFix fix;
+    fix.timestamp = info.timestamp().isValid() ? info.timestamp().toMSecsSinceEpoch() : -1;
+
+    QGeoCoordinate coordinate = info.coordinate();
+    fix.latitude = coordinate.isValid() ? coordinate.latitude() : qQNaN();
+    fix.longitude = coordinate.isValid() ? coordinate.longitude() : qQNaN();
+    fix.altitude = coordinate.type() == QGeoCoordinate::Coordinate3D ? coordinate.altitude() : qQNaN();
+
+    for (int i = 0; i <= QGeoPositionInfo::VerticalAccuracy; ++i) {
+        QGeoPositionInfo::Attribute attribute = QGeoPositionInfo::Attribute(i);
+        fix.attributes[i] = info.hasAttribute(attribute) ? double(info.attribute(attribute)) : qQNaN();
+    }
+    return fix;
+}
+
+/*!
+    Returns \a fix as a QGeoPositionInfo.
+*/
+QGeoPositionInfo QGeoPositionHub::toPositionInfo(const QGeoPositionFix &fix)
+{
+    QGeoPositionInfo info;
+    if (fix.timestamp >= 0)
+        info.setTimestamp(QDateTime::fromMSecsSinceEpoch(fix.timestamp).toUTC());
+    if (!qIsNaN(fix.latitude) && !qIsNaN(fix.longitude)) {
+        if (qIsNaN(fix.altitude))
+            info.setCoordinate(QGeoCoordinate(fix.latitude, fix.longitude));
+        else
+            info.setCoordinate(QGeoCoordinate(fix.latitude, fix.longitude, fix.altitude));
+    }
+
+    for (int i = 0; i <= QGeoPositionInfo::VerticalAccuracy; ++i) {
+        if (!qIsNaN(fix.attributes[i]))
+            info.setAttribute(QGeoPositionInfo::Attribute(i), qreal(fix.attributes[i]));
+    }
+    return info;
+}
+
+/*!
+    \class QGeoPositionHubReader
+    \brief The QGeoPositionHubReader class reads the fixes published by a QGeoPositionHub.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeopositionhub.cpp <QtLocationSubset/QGeoPositionHubReader>
+
+    Each reader keeps its own position in the hub and may be used from any
+    one thread. With a decimation of \e n, read() returns only every
+    \e n-th fix.
+
+    \sa QGeoPositionHub
+*/
+
+/*!
+    Constructs a reader of \a hub that returns every \a decimation-th fix,
+    starting with the next fix that is published.
+
+    The reader must not be used after the hub has been destroyed.
+*/
+QGeoPositionHubReader::QGeoPositionHubReader(QGeoPositionHub *hub, int decimation)
+        : d(new QGeoPositionHubReaderPrivate)
+{
+    d->hub = hub->d;
+    d->next = uint(loadAcquire(d->hub->published));
+    d->decimation = qMax(1, decimation);
+    d->skipped = 0;
+    d->lost = 0;
+}
+
+/*!
+    Destroys the reader.
+*/
+QGeoPositionHubReader::~QGeoPositionHubReader()
+{
+    delete d;
+}
+
+/*!
+    Sets the reader to return only every \a decimation-th fix. A decimation
+    of 1, the default, returns every fix.
+*/
+void QGeoPositionHubReader::setDecimation(int decimation)
+{
+    d->decimation = qMax(1, decimation);
+    d->skipped = 0;
+}
+
+/*!
+    Returns the decimation of the reader.
+*/
+int QGeoPositionHubReader::decimation() const
+{
+    return d->decimation;
+}
+
+/*!
+    Copies the next fix, after the decimation, into \a fix.
+
+    Returns false if no new fix has been published.
+*/
+bool QGeoPositionHubReader::read(QGeoPositionFix *fix)
+{
+    const uint capacity = d->hub->mask + 1;
+    for (;;) {
+        uint published = uint(loadAcquire(d->hub->published));
+        if (published == d->next)
+            return false;
+
+        // the oldest fixes have been overwritten
+        if (published - d->next > capacity) {
+            d->lost += int(published - d->next - capacity);
+            d->next = published - capacity;
+        }
+
+        uint index = d->next++;
+        if (++d->skipped < d->decimation)
+            continue;
+
+        if (!d->hub->readSlot(index, fix)) {
+            ++d->lost;
+            continue;
+        }
+        d->skipped = 0;
+        return true;
+    }
+}
+
+/*!
+    Copies the most recent fix into \a fix and skips all older ones,
+    regardless of the decimation.
+
+    Returns false if no new fix has been published.
+*/
+bool QGeoPositionHubReader::readLatest(QGeoPositionFix *fix)
+{
+    for (;;) {
+        uint published = uint(loadAcquire(d->hub->published));
+        if (published == d->next)
+            return false;
+
+        d->next = published;
+        d->skipped = 0;
+        if (d->hub->readSlot(published - 1, fix))
+            return true;
+    }
+}
+
+/*!
+    Returns the number of fixes that were overwritten before this reader
+    could read them.
+*/
+int QGeoPositionHubReader::lostCount() const
+{
+    return d->lost;
+}
+
+#include "moc_qgeopositionhub.cpp"
+
+QTMS_END_NAMESPACE
@@ -39,19 +39,36 @@
 **
 ****************************************************************************/
 #include "qgeopositioninfo.h"
+#include "qgeocoordinatevalue.h"
 
 #include <QHash>
 #include <QDebug>
 #include <QDataStream>
+#include <QSharedData>
 
 QTMS_BEGIN_NAMESPACE
 
-class QGeoPositionInfoPrivate
+static const int qgeopositioninfo_ATTRIBUTE_COUNT = QGeoPositionInfo::VerticalAccuracy + 1;
+
+/*
+    A position is created and copied for every update, so everything is kept
+    in this one shared object: the timestamp is an implicitly shared
+    QDateTime, which is copied without allocating, and the attributes are a
+    fixed array with a bit per attribute that has been set.
+*/
+class QGeoPositionInfoPrivate : public QSharedData
 {
 public:
+    QGeoPositionInfoPrivate()
+        : attributeMask(0) {
+        for (int i = 0; i < qgeopositioninfo_ATTRIBUTE_COUNT; ++i)
+            attributes[i] = 0;
+    }
+
     QDateTime timestamp;
-    QGeoCoordinate coord;
-    QHash<int, qreal> doubleAttribs;
+    QGeoCoordinateValue coord;
+    uint attributeMask;
+    qreal attributes[qgeopositioninfo_ATTRIBUTE_COUNT];
 };
 
 /*!
@@ -110,9 +127,8 @@ QGeoPositionInfo::QGeoPositionInfo(const QGeoCoordinate &coordinate, const QDate
     Creates a QGeoPositionInfo with the values of \a other.
 */
 QGeoPositionInfo::QGeoPositionInfo(const QGeoPositionInfo &other)
-        : d(new QGeoPositionInfoPrivate)
+        : d(other.d)
 {
-    operator=(other);
 }
 
 /*!
@@ -120,7 +136,6 @@ QGeoPositionInfo::QGeoPositionInfo(const QGeoPositionInfo &other)
 */
 QGeoPositionInfo::~QGeoPositionInfo()
 {
-    delete d;
 }
 
 /*!
@@ -128,13 +143,7 @@ QGeoPositionInfo::~QGeoPositionInfo()
 */
 QGeoPositionInfo &QGeoPositionInfo::operator=(const QGeoPositionInfo & other)
 {
-    if (this == &other)
-        return *this;
-
-    d->timestamp = other.d->timestamp;
-    d->coord = other.d->coord;
-    d->doubleAttribs = other.d->doubleAttribs;
-
+    d = other.d;
     return *this;
 }
 
@@ -144,9 +153,18 @@ QGeoPositionInfo &QGeoPositionInfo::operator=(const QGeoPositionInfo & other)
 */
 bool QGeoPositionInfo::operator==(const QGeoPositionInfo &other) const
 {
-    return d->timestamp == other.d->timestamp
-           && d->coord == other.d->coord
-           && d->doubleAttribs == other.d->doubleAttribs;
+    if (d == other.d)
+        return true;
+
+    if (d->attributeMask != other.d->attributeMask || !(d->coord == other.d->coord))
+        return false;
+
+    for (int i = 0; i < qgeopositioninfo_ATTRIBUTE_COUNT; ++i) {
+        if ((d->attributeMask & (1u << i)) && d->attributes[i] != other.d->attributes[i])
+            return false;
+    }
+
+    return d->timestamp == other.d->timestamp;
 }
 
 /*!
@@ -209,7 +227,7 @@ void QGeoPositionInfo::setCoordinate(const QGeoCoordinate &coordinate)
 */
 QGeoCoordinate QGeoPositionInfo::coordinate() const
 {
-    return d->coord;
+    return d->coord.toCoordinate();
 }
 
 /*!
@@ -219,7 +237,11 @@ QGeoCoordinate QGeoPositionInfo::coordinate() const
 */
 void QGeoPositionInfo::setAttribute(Attribute attribute, qreal value)
 {
-    d->doubleAttribs[int(attribute)] = value;
+    if (uint(attribute) >= uint(qgeopositioninfo_ATTRIBUTE_COUNT))
+        return;
+
+    d->attributes[attribute] = value;
+    d->attributeMask |= 1u << attribute;
 }
 
 /*!
@@ -235,8 +257,8 @@ void QGeoPositionInfo::setAttribute(Attribute attribute, qreal value)
 */
 qreal QGeoPositionInfo::attribute(Attribute attribute) const
 {
-    if (d->doubleAttribs.contains(int(attribute)))
-        return d->doubleAttribs[int(attribute)];
+    if (hasAttribute(attribute))
+        return d->attributes[attribute];
     return -1;
 }
 
@@ -245,7 +267,8 @@ qreal QGeoPositionInfo::attribute(Attribute attribute) const
 */
 void QGeoPositionInfo::removeAttribute(Attribute attribute)
 {
-    d->doubleAttribs.remove(int(attribute));
+    if (hasAttribute(attribute))
+        d->attributeMask &= ~(1u << attribute);
 }
 
 /*!
@@ -254,7 +277,8 @@ void QGeoPositionInfo::removeAttribute(Attribute attribute)
 */
 bool QGeoPositionInfo::hasAttribute(Attribute attribute) const
 {
-    return d->doubleAttribs.contains(int(attribute));
+    return uint(attribute) < uint(qgeopositioninfo_ATTRIBUTE_COUNT)
+           && (d->attributeMask & (1u << attribute));
 }
 
 #ifndef QT_NO_DEBUG_STREAM
@@ -262,12 +286,13 @@ QDebug operator<<(QDebug dbg, const QGeoPositionInfo &info)
 {
     dbg.nospace() << "QGeoPositionInfo(" << info.d->timestamp;
     dbg.nospace() << ", ";
-    dbg.nospace() << info.d->coord;
+    dbg.nospace() << info.d->coord.toCoordinate();
 
-    QList<int> attribs = info.d->doubleAttribs.keys();
-    for (int i = 0; i < attribs.count(); i++) {
+    for (int i = 0; i < qgeopositioninfo_ATTRIBUTE_COUNT; i++) {
+        if (!(info.d->attributeMask & (1u << i)))
+            continue;
         dbg.nospace() << ", ";
-        switch (attribs[i]) {
+        switch (i) {
             case QGeoPositionInfo::Direction:
                 dbg.nospace() << "Direction=";
                 break;
@@ -287,7 +312,7 @@ QDebug operator<<(QDebug dbg, const QGeoPositionInfo &info)
                 dbg.nospace() << "VerticalAccuracy=";
                 break;
         }
-        dbg.nospace() << info.d->doubleAttribs[attribs[i]];
+        dbg.nospace() << info.d->attributes[i];
     }
     dbg.nospace() << ')';
     return dbg;
@@ -306,9 +331,16 @@ QDebug operator<<(QDebug dbg, const QGeoPositionInfo &info)
 
 QDataStream &operator<<(QDataStream &stream, const QGeoPositionInfo &info)
 {
+    // same format as when the attributes were kept in a QHash<int, qreal>
+    QHash<int, qreal> attributes;
+    for (int i = 0; i < qgeopositioninfo_ATTRIBUTE_COUNT; i++) {
+        if (info.d->attributeMask & (1u << i))
+            attributes.insert(i, info.d->attributes[i]);
+    }
+
     stream << info.d->timestamp;
-    stream << info.d->coord;
-    stream << info.d->doubleAttribs;
+    stream << info.d->coord.toCoordinate();
+    stream << attributes;
     return stream;
 }
 #endif
@@ -326,9 +358,19 @@ QDataStream &operator<<(QDataStream &stream, const QGeoPositionInfo &info)
 
 QDataStream &operator>>(QDataStream &stream, QGeoPositionInfo &info)
 {
-    stream >> info.d->timestamp;
-    stream >> info.d->coord;
-    stream >> info.d->doubleAttribs;
+    QDateTime timestamp;
+    QGeoCoordinate coordinate;
+    QHash<int, qreal> attributes;
+    stream >> timestamp;
+    stream >> coordinate;
+    stream >> attributes;
+
+    info.d->timestamp = timestamp;
+    info.d->coord = coordinate;
+    info.d->attributeMask = 0;
+    QHash<int, qreal>::const_iterator it = attributes.constBegin();
+    for (; it != attributes.constEnd(); ++it)
+        info.setAttribute(QGeoPositionInfo::Attribute(it.key()), it.value());
     return stream;
 }
 #endif
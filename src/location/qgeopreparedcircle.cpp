@@ -0,0 +1,205 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qgeopreparedcircle.h"
+#include "qgeoboundingcircle.h"
+#include "qgeocoordinate_p.h"
+
+#include <qnumeric.h>
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+QTMS_BEGIN_NAMESPACE
+
+/*!
+    \class QGeoPreparedCircle
+    \brief The QGeoPreparedCircle class measures many coordinates against one
+    circle.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeopreparedcircle.cpp <QtLocationSubset/QGeoPreparedCircle>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    QGeoCoordinate::distanceTo() converts both coordinates to radians and
+    takes the cosine of both latitudes on every call. A QGeoPreparedCircle
+    does that work for its center once, when it is constructed, so that
+    distanceTo() only has to do it for the other coordinate.
+
+    contains() goes one step further. A coordinate is within the circle when
+    the chord between it and the center is no longer than the chord that
+    spans the radius; the squared half chord is what the haversine formula
+    computes before it takes a square root and an arc sine. The prepared
+    circle compares that value with its own precomputed limit, and needs
+    neither.
+
+    Use a QGeoPreparedCircle in place of QGeoBoundingCircle::contains() or
+    QGeoCoordinate::distanceTo() when the same circle or origin is tested
+    against many coordinates. It calculates as QGeoCoordinate::SphericalDistance
+    does, whatever the QGeoCoordinate::defaultDistanceMode(), and does not use
+    the altitude.
+
+    \sa QGeoBoundingCircle
+*/
+
+/*!
+    Constructs an invalid prepared circle.
+*/
+QGeoPreparedCircle::QGeoPreparedCircle()
+    : m_radius(-1.0)
+{
+    prepare();
+}
+
+/*!
+    Constructs a prepared circle centered at \a center and with a radius of
+    \a radius metres.
+*/
+QGeoPreparedCircle::QGeoPreparedCircle(const QGeoCoordinateValue &center, qreal radius)
+    : m_center(center),
+      m_radius(radius)
+{
+    prepare();
+}
+
+/*!
+    Constructs a prepared circle with the center and radius of \a circle.
+*/
+QGeoPreparedCircle::QGeoPreparedCircle(const QGeoBoundingCircle &circle)
+    : m_center(circle.center()),
+      m_radius(circle.radius())
+{
+    prepare();
+}
+
+void QGeoPreparedCircle::prepare()
+{
+    m_latitudeRad = m_center.latitude() * M_PI / 180;
+    m_longitudeRad = m_center.longitude() * M_PI / 180;
+    m_cosLatitude = cos(m_latitudeRad);
+
+    // The angle the radius spans at the center of the Earth. Beyond half the
+    // circumference the circle covers the whole sphere, and every haversine,
+    // which is at most 1, is within it.
+    double angle = (m_radius > 0 ? m_radius : 0.0) / (qgeocoordinate_EARTH_MEAN_RADIUS * 1000.0);
+    if (angle >= M_PI) {
+        m_maxHaversine = 2.0;
+    } else {
+        double halfChord = sin(angle / 2.0);
+        m_maxHaversine = halfChord * halfChord;
+    }
+}
+
+/*!
+    Returns whether this prepared circle is valid.
+
+    As for QGeoBoundingCircle, a valid circle has a valid center coordinate
+    and a radius greater than or equal to zero.
+*/
+bool QGeoPreparedCircle::isValid() const
+{
+    return (m_center.isValid()
+            && !qIsNaN(m_radius)
+            && m_radius >= -1e-7);
+}
+
+/*!
+    \fn QGeoCoordinateValue QGeoPreparedCircle::center() const
+
+    Returns the center coordinate of this prepared circle.
+*/
+
+/*!
+    \fn qreal QGeoPreparedCircle::radius() const
+
+    Returns the radius in metres of this prepared circle.
+*/
+
+/*!
+    Returns the distance in metres from the center of this circle to
+    \a coordinate, as QGeoCoordinate::distanceTo() would.
+
+    Returns 0 if the center or \a coordinate is invalid.
+*/
+qreal QGeoPreparedCircle::distanceTo(const QGeoCoordinateValue &coordinate) const
+{
+    if (!m_center.isValid() || !coordinate.isValid())
+        return 0;
+
+    double y = haversine(coordinate);
+    if (y > 1.0)
+        y = 1.0;
+    return qreal(2 * asin(sqrt(y)) * qgeocoordinate_EARTH_MEAN_RADIUS * 1000);
+}
+
+/*!
+    Returns whether \a coordinate is contained within this circle, that is
+    whether its distance from the center is no more than the radius.
+
+    Returns false if this circle or \a coordinate is invalid.
+*/
+bool QGeoPreparedCircle::contains(const QGeoCoordinateValue &coordinate) const
+{
+    if (!isValid() || !coordinate.isValid())
+        return false;
+
+    return haversine(coordinate) <= m_maxHaversine;
+}
+
+double QGeoPreparedCircle::haversine(const QGeoCoordinateValue &coordinate) const
+{
+    double latRad = coordinate.latitude() * M_PI / 180;
+    double lonRad = coordinate.longitude() * M_PI / 180;
+    double haversine_dlat = sin((latRad - m_latitudeRad) / 2.0);
+    haversine_dlat *= haversine_dlat;
+    double haversine_dlon = sin((lonRad - m_longitudeRad) / 2.0);
+    haversine_dlon *= haversine_dlon;
+    return haversine_dlat + m_cosLatitude * cos(latRad) * haversine_dlon;
+}
+
+QTMS_END_NAMESPACE
@@ -0,0 +1,564 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qgeospatialindex.h"
+#include "qgeospatialindex_p.h"
+#include "qgeoboundingbox.h"
+#include "qgeoboundingcircle.h"
+#include "qgeoplace.h"
+#include "qgeopreparedcircle.h"
+#include "qgeocoordinate_p.h"
+
+#include <QPair>
+#include <QtAlgorithms>
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+QTMS_BEGIN_NAMESPACE
+
+// The number of children of a node.
+static const int qgeospatialindex_NODE_SIZE = 16;
+
+// Widens the bounds computed for a circle, so that rounding cannot exclude
+// a coordinate that QGeoPreparedCircle::contains() accepts.
+static const double qgeospatialindex_MARGIN = 1e-9;
+
+static inline double qgeospatialindex_latitude(const QGeoSpatialIndexEntry &entry)
+{
+    return entry.latitude;
+}
+
+static inline double qgeospatialindex_longitude(const QGeoSpatialIndexEntry &entry)
+{
+    return entry.longitude;
+}
+
+static inline double qgeospatialindex_latitude(const QGeoSpatialIndexNode &node)
+{
+    return (node.minLatitude + node.maxLatitude) / 2;
+}
+
+static inline double qgeospatialindex_longitude(const QGeoSpatialIndexNode &node)
+{
+    return (node.minLongitude + node.maxLongitude) / 2;
+}
+
+template <typename T>
+static bool qgeospatialindex_latitudeLessThan(const T &a, const T &b)
+{
+    return qgeospatialindex_latitude(a) < qgeospatialindex_latitude(b);
+}
+
+template <typename T>
+static bool qgeospatialindex_longitudeLessThan(const T &a, const T &b)
+{
+    return qgeospatialindex_longitude(a) < qgeospatialindex_longitude(b);
+}
+
+// Orders items for packing with Sort-Tile-Recursive: items are sorted by
+// longitude into vertical slices of about sqrt(nodes) nodes each, and by
+// latitude within each slice. Groups of NODE_SIZE consecutive items then
+// make compact nodes.
+template <typename T>
+static void qgeospatialindex_sortTileRecursive(T *data, int count)
+{
+    int nodeCount = (count + qgeospatialindex_NODE_SIZE - 1) / qgeospatialindex_NODE_SIZE;
+    int sliceCount = int(ceil(sqrt(double(nodeCount))));
+    int sliceSize = sliceCount * qgeospatialindex_NODE_SIZE;
+
+    qSort(data, data + count, qgeospatialindex_longitudeLessThan<T>);
+    for (int start = 0; start < count; start += sliceSize)
+        qSort(data + start, data + qMin(start + sliceSize, count), qgeospatialindex_latitudeLessThan<T>);
+}
+
+static void qgeospatialindex_extend(QGeoSpatialIndexNode *node, double minLatitude, double maxLatitude,
+                                    double minLongitude, double maxLongitude)
+{
+    node->minLatitude = qMin(node->minLatitude, minLatitude);
+    node->maxLatitude = qMax(node->maxLatitude, maxLatitude);
+    node->minLongitude = qMin(node->minLongitude, minLongitude);
+    node->maxLongitude = qMax(node->maxLongitude, maxLongitude);
+}
+
+static QGeoSpatialIndexNode qgeospatialindex_emptyNode(int first, int last)
+{
+    QGeoSpatialIndexNode node;
+    node.minLatitude = 90.0;
+    node.maxLatitude = -90.0;
+    node.minLongitude = 180.0;
+    node.maxLongitude = -180.0;
+    node.first = first;
+    node.last = last;
+    return node;
+}
+
+// Up to two longitude intervals, for areas that cross the antimeridian.
+struct QGeoSpatialIndexLongitudes
+{
+    double west[2];
+    double east[2];
+    int count;
+
+    void set(double westLongitude, double eastLongitude) {
+        if (westLongitude <= eastLongitude) {
+            west[0] = westLongitude;
+            east[0] = eastLongitude;
+            count = 1;
+        } else {
+            west[0] = westLongitude;
+            east[0] = 180.0;
+            west[1] = -180.0;
+            east[1] = eastLongitude;
+            count = 2;
+        }
+    }
+
+    bool overlaps(double minLongitude, double maxLongitude) const {
+        for (int i = 0; i < count; ++i) {
+            if (minLongitude <= east[i] && maxLongitude >= west[i])
+                return true;
+        }
+        return false;
+    }
+
+    bool contains(double longitude) const {
+        return overlaps(longitude, longitude);
+    }
+};
+
+// Matches what QGeoBoundingBox::contains() accepts.
+struct QGeoSpatialIndexBoxFilter
+{
+    double top;
+    double bottom;
+    QGeoSpatialIndexLongitudes longitudes;
+
+    bool overlaps(const QGeoSpatialIndexNode &node) const {
+        if (node.minLatitude > top || node.maxLatitude < bottom)
+            return false;
+        // Any longitude is within a box at a pole it touches.
+        if ((top == 90.0 && node.maxLatitude == 90.0)
+                || (bottom == -90.0 && node.minLatitude == -90.0))
+            return true;
+        return longitudes.overlaps(node.minLongitude, node.maxLongitude);
+    }
+
+    bool accepts(const QGeoSpatialIndexEntry &entry) const {
+        if (entry.latitude > top || entry.latitude < bottom)
+            return false;
+        if ((entry.latitude == 90.0 && top == 90.0)
+                || (entry.latitude == -90.0 && bottom == -90.0))
+            return true;
+        return longitudes.contains(entry.longitude);
+    }
+};
+
+// Narrows the search to the box around the circle, and matches what
+// QGeoBoundingCircle::contains() accepts within it.
+struct QGeoSpatialIndexCircleFilter
+{
+    double top;
+    double bottom;
+    QGeoSpatialIndexLongitudes longitudes;
+    QGeoPreparedCircle circle;
+
+    QGeoSpatialIndexCircleFilter(const QGeoCoordinateValue &center, qreal radius)
+        : circle(center, radius)
+    {
+        double angle = (radius > 0 ? radius : 0.0) / (qgeocoordinate_EARTH_MEAN_RADIUS * 1000.0);
+        double degrees = angle * 180.0 / M_PI + qgeospatialindex_MARGIN;
+        double latitude = center.latitude();
+
+        top = latitude + degrees;
+        bottom = latitude - degrees;
+        if (top >= 90.0 || bottom <= -90.0 || angle >= M_PI) {
+            // the circle covers a pole, and with it every longitude
+            longitudes.set(-180.0, 180.0);
+        } else {
+            double latitudeRad = latitude * M_PI / 180.0;
+            double spread = asin(qMin(sin(angle) / cos(latitudeRad), 1.0)) * 180.0 / M_PI
+                            + qgeospatialindex_MARGIN;
+            double west = center.longitude() - spread;
+            double east = center.longitude() + spread;
+            if (west < -180.0)
+                west += 360.0;
+            if (east > 180.0)
+                east -= 360.0;
+            longitudes.set(west, east);
+        }
+    }
+
+    bool overlaps(const QGeoSpatialIndexNode &node) const {
+        if (node.minLatitude > top || node.maxLatitude < bottom)
+            return false;
+        return longitudes.overlaps(node.minLongitude, node.maxLongitude);
+    }
+
+    bool accepts(const QGeoSpatialIndexEntry &entry) const {
+        return circle.contains(QGeoCoordinateValue(entry.latitude, entry.longitude));
+    }
+};
+
+/*!
+    \class QGeoSpatialIndex
+    \brief The QGeoSpatialIndex class finds the coordinates of a fixed
+    collection that lie within an area, or near a coordinate.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qgeospatialindex.cpp <QtLocationSubset/QGeoSpatialIndex>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    A QGeoSpatialIndex is built once from a list of coordinates or places,
+    and can then be queried any number of times for the items within a
+    QGeoBoundingBox or a QGeoBoundingCircle, or for the items nearest to a
+    coordinate. Items are identified by their index in the list the spatial
+    index was built from.
+
+    The coordinates are held in a packed R-tree: they are grouped into
+    nodes of up to 16 neighbouring coordinates, those nodes into nodes of
+    up to 16 nodes, and so on, and a query only visits the nodes whose
+    bounds it overlaps. Building the index takes O(n log n) time for n
+    coordinates, and a query about O(log n + k) for k results, where
+    filtering the list would take O(n) per query. A single query is
+    cheaper without an index; build one when the same collection is
+    queried repeatedly.
+
+    Queries return the same items that QGeoBoundingBox::contains() and
+    QGeoBoundingCircle::contains() accept, including for boxes that cross
+    the antimeridian and areas that touch the poles. Invalid coordinates
+    are kept in the index, so that the indexes of the others do not change,
+    but no query returns them.
+
+    QGeoSpatialIndex is implicitly shared, and cannot be modified once it is
+    built.
+*/
+
+/*!
+    Constructs an empty spatial index.
+*/
+QGeoSpatialIndex::QGeoSpatialIndex()
+    : d_ptr(new QGeoSpatialIndexPrivate()) {}
+
+/*!
+    Constructs a spatial index of \a coordinates.
+*/
+QGeoSpatialIndex::QGeoSpatialIndex(const QList<QGeoCoordinate> &coordinates)
+    : d_ptr(new QGeoSpatialIndexPrivate())
+{
+    d_ptr->coordinates.reserve(coordinates.size());
+    for (int i = 0; i < coordinates.size(); ++i)
+        d_ptr->coordinates.append(coordinates.at(i));
+    d_ptr->build();
+}
+
+/*!
+    Constructs a spatial index of the coordinates of \a places.
+*/
+QGeoSpatialIndex::QGeoSpatialIndex(const QList<QGeoPlace> &places)
+    : d_ptr(new QGeoSpatialIndexPrivate())
+{
+    d_ptr->coordinates.reserve(places.size());
+    for (int i = 0; i < places.size(); ++i)
+        d_ptr->coordinates.append(places.at(i).coordinate());
+    d_ptr->build();
+}
+
+/*!
+    Constructs a spatial index from the contents of \a other.
+*/
+QGeoSpatialIndex::QGeoSpatialIndex(const QGeoSpatialIndex &other)
+    : d_ptr(other.d_ptr) {}
+
+/*!
+    Destroys this spatial index.
+*/
+QGeoSpatialIndex::~QGeoSpatialIndex() {}
+
+/*!
+    Assigns \a other to this spatial index and returns a reference to this
+    spatial index.
+*/
+QGeoSpatialIndex &QGeoSpatialIndex::operator=(const QGeoSpatialIndex &other)
+{
+    d_ptr = other.d_ptr;
+    return *this;
+}
+
+/*!
+    Returns the number of items in this spatial index, including those with
+    an invalid coordinate.
+*/
+int QGeoSpatialIndex::count() const
+{
+    return d_ptr->coordinates.size();
+}
+
+/*!
+    Returns the coordinate of the item at \a index.
+*/
+QGeoCoordinate QGeoSpatialIndex::coordinate(int index) const
+{
+    return d_ptr->coordinates.at(index).toCoordinate();
+}
+
+/*!
+    Returns the indexes, in increasing order, of the items whose coordinate
+    is within \a box.
+
+    \sa QGeoBoundingBox::contains()
+*/
+QList<int> QGeoSpatialIndex::indexesWithin(const QGeoBoundingBox &box) const
+{
+    QList<int> result;
+    if (!box.isValid())
+        return result;
+
+    QGeoCoordinate topLeft = box.topLeft();
+    QGeoCoordinate bottomRight = box.bottomRight();
+
+    QGeoSpatialIndexBoxFilter filter;
+    filter.top = topLeft.latitude();
+    filter.bottom = bottomRight.latitude();
+    filter.longitudes.set(topLeft.longitude(), bottomRight.longitude());
+
+    d_ptr->search(filter, &result);
+    qSort(result);
+    return result;
+}
+
+/*!
+    Returns the indexes, in increasing order, of the items whose coordinate
+    is within \a circle.
+
+    \sa QGeoBoundingCircle::contains()
+*/
+QList<int> QGeoSpatialIndex::indexesWithin(const QGeoBoundingCircle &circle) const
+{
+    QList<int> result;
+    if (!circle.isValid())
+        return result;
+
+    d_ptr->indexesWithin(circle.center(), circle.radius(), &result);
+    qSort(result);
+    return result;
+}
+
+/*!
+    Returns the indexes, in increasing order, of the items whose coordinate
+    is within \a area, which must be a QGeoBoundingBox or a
+    QGeoBoundingCircle.
+*/
+QList<int> QGeoSpatialIndex::indexesWithin(const QGeoBoundingArea &area) const
+{
+    switch (area.type()) {
+    case QGeoBoundingArea::BoxType:
+        return indexesWithin(static_cast<const QGeoBoundingBox &>(area));
+    case QGeoBoundingArea::CircleType:
+        return indexesWithin(static_cast<const QGeoBoundingCircle &>(area));
+    }
+    return QList<int>();
+}
+
+/*!
+    Returns the indexes of the \a count items nearest to \a coordinate,
+    nearest first. Fewer are returned if the index has fewer items with a
+    valid coordinate, and none if \a coordinate is invalid.
+
+    Distances are measured as by QGeoCoordinate::SphericalDistance.
+
+    \sa QGeoCoordinate::distanceTo()
+*/
+QList<int> QGeoSpatialIndex::nearest(const QGeoCoordinate &coordinate, int count) const
+{
+    QList<int> result;
+    int available = d_ptr->entries.size();
+    if (!coordinate.isValid() || count <= 0 || available == 0)
+        return result;
+
+    QGeoCoordinateValue center(coordinate);
+    QGeoPreparedCircle origin(center, 0);
+    const double halfCircumference = M_PI * qgeocoordinate_EARTH_MEAN_RADIUS * 1000.0;
+
+    // Guess the radius that holds count items if they were spread evenly
+    // over the root's bounds, and double it until it does. Every item within
+    // the final circle is nearer than every item outside it, so the nearest
+    // count items within it are the nearest overall.
+    const QGeoSpatialIndexNode &root = d_ptr->nodes.last();
+    double height = (root.maxLatitude - root.minLatitude) * M_PI / 180.0;
+    double width = (root.maxLongitude - root.minLongitude) * M_PI / 180.0
+                   * cos((root.maxLatitude + root.minLatitude) / 2 * M_PI / 180.0);
+    double area = qMax(height * width, 1e-12);
+    double radius = sqrt(qMin(count, available) * area / (M_PI * available))
+                    * qgeocoordinate_EARTH_MEAN_RADIUS * 1000.0;
+    radius = qMax(radius, 1.0);
+
+    QList<int> candidates;
+    for (;;) {
+        candidates.clear();
+        if (radius >= halfCircumference) {
+            for (int i = 0; i < available; ++i)
+                candidates.append(d_ptr->entries.at(i).index);
+            break;
+        }
+        d_ptr->indexesWithin(center, radius, &candidates);
+        if (candidates.size() >= count)
+            break;
+        radius *= 2;
+    }
+
+    QVector<QPair<qreal, int> > distances;
+    distances.reserve(candidates.size());
+    for (int i = 0; i < candidates.size(); ++i) {
+        int index = candidates.at(i);
+        distances.append(qMakePair(origin.distanceTo(d_ptr->coordinates.at(index)), index));
+    }
+    qSort(distances);
+
+    int resultCount = qMin(count, distances.size());
+    for (int i = 0; i < resultCount; ++i)
+        result.append(distances.at(i).second);
+    return result;
+}
+
+/*******************************************************************************
+*******************************************************************************/
+
+QGeoSpatialIndexPrivate::QGeoSpatialIndexPrivate()
+    : QSharedData(),
+      leafCount(0) {}
+
+void QGeoSpatialIndexPrivate::build()
+{
+    entries.clear();
+    nodes.clear();
+    leafCount = 0;
+
+    for (int i = 0; i < coordinates.size(); ++i) {
+        const QGeoCoordinateValue &coordinate = coordinates.at(i);
+        if (!coordinate.isValid())
+            continue;
+        QGeoSpatialIndexEntry entry;
+        entry.latitude = coordinate.latitude();
+        entry.longitude = coordinate.longitude();
+        entry.index = i;
+        entries.append(entry);
+    }
+    if (entries.isEmpty())
+        return;
+
+    qgeospatialindex_sortTileRecursive(entries.data(), entries.size());
+    for (int first = 0; first < entries.size(); first += qgeospatialindex_NODE_SIZE) {
+        int last = qMin(first + qgeospatialindex_NODE_SIZE, entries.size());
+        QGeoSpatialIndexNode node = qgeospatialindex_emptyNode(first, last);
+        for (int i = first; i < last; ++i) {
+            const QGeoSpatialIndexEntry &entry = entries.at(i);
+            qgeospatialindex_extend(&node, entry.latitude, entry.latitude,
+                                    entry.longitude, entry.longitude);
+        }
+        nodes.append(node);
+    }
+    leafCount = nodes.size();
+
+    // Each level is ordered before its parents are made, which is possible
+    // because nothing refers to its nodes yet.
+    int levelStart = 0;
+    while (nodes.size() - levelStart > 1) {
+        int levelEnd = nodes.size();
+
+        qgeospatialindex_sortTileRecursive(nodes.data() + levelStart, levelEnd - levelStart);
+
+        for (int first = levelStart; first < levelEnd; first += qgeospatialindex_NODE_SIZE) {
+            int last = qMin(first + qgeospatialindex_NODE_SIZE, levelEnd);
+            QGeoSpatialIndexNode node = qgeospatialindex_emptyNode(first, last);
+            for (int i = first; i < last; ++i) {
+                const QGeoSpatialIndexNode &child = nodes.at(i);
+                qgeospatialindex_extend(&node, child.minLatitude, child.maxLatitude,
+                                        child.minLongitude, child.maxLongitude);
+            }
+            nodes.append(node);
+        }
+        levelStart = levelEnd;
+    }
+}
+
+template <typename Filter>
+void QGeoSpatialIndexPrivate::search(const Filter &filter, QList<int> *result) const
+{
+    if (nodes.isEmpty())
+        return;
+
+    QVector<int> pending;
+    pending.append(nodes.size() - 1);
+    while (!pending.isEmpty()) {
+        const QGeoSpatialIndexNode &node = nodes.at(pending.last());
+        bool leaf = pending.last() < leafCount;
+        pending.removeLast();
+
+        if (!filter.overlaps(node))
+            continue;
+
+        for (int i = node.first; i < node.last; ++i) {
+            if (leaf) {
+                if (filter.accepts(entries.at(i)))
+                    result->append(entries.at(i).index);
+            } else {
+                pending.append(i);
+            }
+        }
+    }
+}
+
+void QGeoSpatialIndexPrivate::indexesWithin(const QGeoCoordinateValue &center, qreal radius,
+                                            QList<int> *result) const
+{
+    QGeoSpatialIndexCircleFilter filter(center, radius);
+    search(filter, result);
+}
+
+QTMS_END_NAMESPACE
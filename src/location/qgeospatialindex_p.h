@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGEOSPATIALINDEX_P_H
+#define QGEOSPATIALINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qgeospatialindex.h"
+#include "qgeocoordinatevalue.h"
+
+#include <QSharedData>
+#include <QVector>
+
+QTMS_BEGIN_NAMESPACE
+
+struct QGeoSpatialIndexEntry
+{
+    double latitude;
+    double longitude;
+    int index;
+};
+
+// A node's children are entries [first, last) for a leaf, and nodes
+// [first, last) otherwise.
+struct QGeoSpatialIndexNode
+{
+    double minLatitude;
+    double maxLatitude;
+    double minLongitude;
+    double maxLongitude;
+    int first;
+    int last;
+};
+
+class QGeoSpatialIndexPrivate : public QSharedData
+{
+public:
+    QGeoSpatialIndexPrivate();
+
+    void build();
+
+    // Calls filter.accepts() for the entries of every leaf for which
+    // filter.overlaps() holds on the path from the root, and appends the
+    // indexes of the accepted ones to result.
+    template <typename Filter>
+    void search(const Filter &filter, QList<int> *result) const;
+
+    void indexesWithin(const QGeoCoordinateValue &center, qreal radius, QList<int> *result) const;
+
+    // All coordinates, by index, including invalid ones.
+    QVector<QGeoCoordinateValue> coordinates;
+    // The valid coordinates, in the order of the leaves.
+    QVector<QGeoSpatialIndexEntry> entries;
+    // The leaves come first and the root last.
+    QVector<QGeoSpatialIndexNode> nodes;
+    int leafCount;
+};
+
+QTMS_END_NAMESPACE
+
+#endif
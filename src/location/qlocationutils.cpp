@@ -40,305 +40,730 @@
 ****************************************************************************/
 #include "qlocationutils_p.h"
 #include "qgeopositioninfo.h"
+#include "qgeosatelliteinfo.h"
 
 #include <QTime>
 #include <QList>
 #include <QByteArray>
 #include <QDebug>
+#include <qnumeric.h>
 
 #include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define QLOCATIONUTILS_NMEA_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define QLOCATIONUTILS_NMEA_NEON
+#endif
 
 QTMS_BEGIN_NAMESPACE
 
-// converts e.g. 15306.0235 from NMEA sentence to 153.100392
-static double qlocationutils_nmeaDegreesToDecimal(double nmeaDegrees)
+// Upper bound on the number of fields recorded for one sentence. None of the
+// readers look past field 11; if a sentence has more fields than this, the
+// last recorded field holds the remainder of the sentence.
+static const int qlocationutils_MAX_NMEA_FIELDS = 32;
+
+// The comma separated fields of one NMEA sentence. Each field points into the
+// caller's buffer rather than owning a copy, so splitting a sentence does not
+// allocate. The fields are the same as those of QByteArray::split(',').
+struct QNmeaSentenceFields
 {
-    double deg;
-    double min = 100.0 * modf(nmeaDegrees / 100.0, &deg);
-    return deg + (min / 60.0);
+    const char *data[qlocationutils_MAX_NMEA_FIELDS];
+    int size[qlocationutils_MAX_NMEA_FIELDS];
+    int count;
+};
+
+// Powers of ten that are exactly representable as a double.
+static const double qlocationutils_exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static void qlocationutils_splitNmeaSentence(const char *data, int size, QNmeaSentenceFields *fields)
+{
+    const char *start = data;
+    const char *end = data + size;
+    int count = 0;
+
+    while (count < qlocationutils_MAX_NMEA_FIELDS - 1) {
+        const char *comma = static_cast<const char *>(memchr(start, ',', end - start));
+        if (!comma)
+            break;
+        fields->data[count] = start;
+        fields->size[count] = int(comma - start);
+        ++count;
+        start = comma + 1;
+    }
+
+    fields->data[count] = start;
+    fields->size[count] = int(end - start);
+    fields->count = count + 1;
 }
 
-static void qlocationutils_readGga(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
-{
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
-    QGeoCoordinate coord;
+/*
+    Same result as QByteArray::toDouble() on the field, without a copy.
 
-    if (hasFix && parts.count() > 6 && parts[6].count() > 0)
-        *hasFix = parts[6].toInt() > 0;
+    Plain decimal numbers, which is all that NMEA uses, are accumulated into an
+    integer mantissa and scaled by an exact power of ten. Since both operands
+    are exact, the single division is correctly rounded, exactly like strtod().
+    Anything else (exponents, whitespace, very long mantissas) goes through Qt.
+*/
+static bool qlocationutils_parseDouble(const char *data, int size, double *value)
+{
+    const char *p = data;
+    const char *end = data + size;
 
-    if (parts.count() > 1 && parts[1].count() > 0) {
-        QTime time;
-        if (QLocationUtils::getNmeaTime(parts[1], &time))
-            info->setTimestamp(QDateTime(QDate(), time, Qt::UTC));
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
     }
 
-    if (parts.count() > 5 && parts[3].count() == 1 && parts[5].count() == 1) {
-        double lat;
-        double lng;
-        if (QLocationUtils::getNmeaLatLong(parts[2], parts[3][0], parts[4], parts[5][0], &lat, &lng)) {
-            coord.setLatitude(lat);
-            coord.setLongitude(lng);
+    quint64 mantissa = 0;
+    int digits = 0;
+    int fractionDigits = 0;
+    bool hasPoint = false;
+    for (; p < end; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            mantissa = mantissa * 10 + (*p - '0');
+            ++digits;
+            if (hasPoint)
+                ++fractionDigits;
+        } else if (*p == '.' && !hasPoint) {
+            hasPoint = true;
+        } else {
+            break;
         }
     }
 
-    if (parts.count() > 9 && parts[9].count() > 0) {
-        bool hasAlt = false;
-        double alt = parts[9].toDouble(&hasAlt);
-        if (hasAlt)
-            coord.setAltitude(alt);
+    // 15 digits always fit in the 53 bit significand of a double
+    if (p == end && digits > 0 && digits <= 15) {
+        double result = double(mantissa) / qlocationutils_exactPowersOfTen[fractionDigits];
+        *value = negative ? -result : result;
+        return true;
     }
 
-    if (coord.type() != QGeoCoordinate::InvalidCoordinate)
-        info->setCoordinate(coord);
+    bool ok = false;
+    double result = QByteArray::fromRawData(data, size).toDouble(&ok);
+    if (ok)
+        *value = result;
+    return ok;
 }
 
-static void qlocationutils_readGll(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
+/*
+    Same result as QByteArray::toUInt() on the field, without a copy for the
+    plain digit strings used by NMEA.
+*/
+static uint qlocationutils_parseUInt(const char *data, int size, bool *ok = 0)
 {
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
-    QGeoCoordinate coord;
+    if (size > 0 && size <= 9) {
+        uint result = 0;
+        int i = 0;
+        for (; i < size && data[i] >= '0' && data[i] <= '9'; ++i)
+            result = result * 10 + (data[i] - '0');
+        if (i == size) {
+            if (ok)
+                *ok = true;
+            return result;
+        }
+    }
 
-    if (hasFix && parts.count() > 6 && parts[6].count() > 0)
-        *hasFix = (parts[6][0] == 'A');
+    return QByteArray::fromRawData(data, size).toUInt(ok);
+}
 
-    if (parts.count() > 5 && parts[5].count() > 0) {
-        QTime time;
-        if (QLocationUtils::getNmeaTime(parts[5], &time))
-            info->setTimestamp(QDateTime(QDate(), time, Qt::UTC));
+// Reads two decimal digits, returns -1 if either is not a digit.
+inline static int qlocationutils_twoDigits(const char *data)
+{
+    if (data[0] < '0' || data[0] > '9' || data[1] < '0' || data[1] > '9')
+        return -1;
+    return (data[0] - '0') * 10 + (data[1] - '0');
+}
+
+/*
+    Returns zero if \a c is the hex digit for \a nibble, in either upper or
+    lower case, and non-zero otherwise. Only 'A' to 'F' are case folded so
+    that no other character can alias a digit; there are no branches.
+*/
+inline static int qlocationutils_hexDigitMismatch(uchar c, int nibble)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    int isUpperHexLetter = uchar(c - 'A') < 6;
+    return (c | (isUpperHexLetter << 5)) ^ hexDigits[nibble];
+}
+
+// converts e.g. 15306.0235 from NMEA sentence to 153.100392
+static double qlocationutils_nmeaDegreesToDecimal(double nmeaDegrees)
+{
+    double deg;
+    double min = 100.0 * modf(nmeaDegrees / 100.0, &deg);
+    return deg + (min / 60.0);
+}
+
+// Values decoded from a single sentence. Only the values flagged in fields
+// are present; qlocationutils_applyNmeaData() copies them into a
+// QGeoPositionInfo, while getPosInfoFromNmeaBuffer() writes them straight
+// into the caller's arrays.
+struct QNmeaSentenceData
+{
+    enum Field {
+        Timestamp = 0x01,
+        Coordinate = 0x02,
+        GroundSpeed = 0x04,
+        Direction = 0x08,
+        MagneticVariation = 0x10,
+        HorizontalAccuracy = 0x20,
+        VerticalAccuracy = 0x40
+    };
+
+    QNmeaSentenceData()
+        : fields(0), latitude(0.0), longitude(0.0), altitude(qQNaN()),
+          groundSpeed(0.0), direction(0.0), magneticVariation(0.0),
+          horizontalAccuracy(0.0), verticalAccuracy(0.0) {}
+
+    int fields;
+    QDate date;
+    QTime time;
+    double latitude;
+    double longitude;
+    double altitude;
+    double groundSpeed;
+    double direction;
+    double magneticVariation;
+    double horizontalAccuracy;
+    double verticalAccuracy;
+};
+
+static void qlocationutils_readGga(const QNmeaSentenceFields &parts, QNmeaSentenceData *sentence, bool *hasFix)
+{
+    if (hasFix && parts.count > 6 && parts.size[6] > 0)
+        *hasFix = qlocationutils_parseUInt(parts.data[6], parts.size[6]) > 0;
+
+    if (parts.count > 1 && parts.size[1] > 0) {
+        if (QLocationUtils::getNmeaTime(parts.data[1], parts.size[1], &sentence->time))
+            sentence->fields |= QNmeaSentenceData::Timestamp;
     }
 
-    if (parts.count() > 4 && parts[2].count() == 1 && parts[4].count() == 1) {
-        double lat;
-        double lng;
-        if (QLocationUtils::getNmeaLatLong(parts[1], parts[2][0], parts[3], parts[4][0], &lat, &lng)) {
-            coord.setLatitude(lat);
-            coord.setLongitude(lng);
+    if (parts.count > 5 && parts.size[3] == 1 && parts.size[5] == 1) {
+        if (QLocationUtils::getNmeaLatLong(parts.data[2], parts.size[2], parts.data[3][0],
+                                           parts.data[4], parts.size[4], parts.data[5][0],
+                                           &sentence->latitude, &sentence->longitude)) {
+            sentence->fields |= QNmeaSentenceData::Coordinate;
         }
     }
 
-    if (coord.type() != QGeoCoordinate::InvalidCoordinate)
-        info->setCoordinate(coord);
+    if (parts.count > 9 && parts.size[9] > 0)
+        qlocationutils_parseDouble(parts.data[9], parts.size[9], &sentence->altitude);
 }
 
-static void qlocationutils_readRmc(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
+static void qlocationutils_readGll(const QNmeaSentenceFields &parts, QNmeaSentenceData *sentence, bool *hasFix)
 {
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
-    QGeoCoordinate coord;
-    QDate date;
-    QTime time;
+    if (hasFix && parts.count > 6 && parts.size[6] > 0)
+        *hasFix = (parts.data[6][0] == 'A');
+
+    if (parts.count > 5 && parts.size[5] > 0) {
+        if (QLocationUtils::getNmeaTime(parts.data[5], parts.size[5], &sentence->time))
+            sentence->fields |= QNmeaSentenceData::Timestamp;
+    }
 
-    if (hasFix && parts.count() > 2 && parts[2].count() > 0)
-        *hasFix = (parts[2][0] == 'A');
+    if (parts.count > 4 && parts.size[2] == 1 && parts.size[4] == 1) {
+        if (QLocationUtils::getNmeaLatLong(parts.data[1], parts.size[1], parts.data[2][0],
+                                           parts.data[3], parts.size[3], parts.data[4][0],
+                                           &sentence->latitude, &sentence->longitude)) {
+            sentence->fields |= QNmeaSentenceData::Coordinate;
+        }
+    }
+}
 
-    if (parts.count() > 9 && parts[9].count() == 6) {
-        date = QDate::fromString(parts[9], "ddMMyy");
-        if (date.isValid())
-            date = date.addYears(100);     // otherwise starts from 1900
-        else
-            date = QDate();
+static void qlocationutils_readRmc(const QNmeaSentenceFields &parts, QNmeaSentenceData *sentence, bool *hasFix)
+{
+    if (hasFix && parts.count > 2 && parts.size[2] > 0)
+        *hasFix = (parts.data[2][0] == 'A');
+
+    if (parts.count > 9 && parts.size[9] == 6) {
+        // ddMMyy, with the year taken to be after 2000. Validating against
+        // 19yy first keeps the behavior of QDate::fromString() + addYears(100).
+        int day = qlocationutils_twoDigits(parts.data[9]);
+        int month = qlocationutils_twoDigits(parts.data[9] + 2);
+        int year = qlocationutils_twoDigits(parts.data[9] + 4);
+        if (day >= 0 && month >= 0 && year >= 0 && QDate::isValid(1900 + year, month, day))
+            sentence->date = QDate(2000 + year, month, day);
     }
 
-    if (parts.count() > 1 && parts[1].count() > 0)
-        QLocationUtils::getNmeaTime(parts[1], &time);
+    if (parts.count > 1 && parts.size[1] > 0)
+        QLocationUtils::getNmeaTime(parts.data[1], parts.size[1], &sentence->time);
+
+    // RMC always carries a timestamp, even if the date or time is invalid
+    sentence->fields |= QNmeaSentenceData::Timestamp;
 
-    if (parts.count() > 6 && parts[4].count() == 1 && parts[6].count() == 1) {
-        double lat;
-        double lng;
-        if (QLocationUtils::getNmeaLatLong(parts[3], parts[4][0], parts[5], parts[6][0], &lat, &lng)) {
-            coord.setLatitude(lat);
-            coord.setLongitude(lng);
+    if (parts.count > 6 && parts.size[4] == 1 && parts.size[6] == 1) {
+        if (QLocationUtils::getNmeaLatLong(parts.data[3], parts.size[3], parts.data[4][0],
+                                           parts.data[5], parts.size[5], parts.data[6][0],
+                                           &sentence->latitude, &sentence->longitude)) {
+            sentence->fields |= QNmeaSentenceData::Coordinate;
         }
     }
 
-    bool parsed = false;
     double value = 0.0;
-    if (parts.count() > 7 && parts[7].count() > 0) {
-        value = parts[7].toDouble(&parsed);
-        if (parsed)
-            info->setAttribute(QGeoPositionInfo::GroundSpeed, qreal(value * 1.852 / 3.6));    // knots -> m/s
-    }
-    if (parts.count() > 8 && parts[8].count() > 0) {
-        value = parts[8].toDouble(&parsed);
-        if (parsed)
-            info->setAttribute(QGeoPositionInfo::Direction, qreal(value));
-    }
-    if (parts.count() > 11 && parts[11].count() == 1
-            && (parts[11][0] == 'E' || parts[11][0] == 'W')) {
-        value = parts[10].toDouble(&parsed);
-        if (parsed) {
-            if (parts[11][0] == 'W')
+    if (parts.count > 7 && parts.size[7] > 0) {
+        if (qlocationutils_parseDouble(parts.data[7], parts.size[7], &value)) {
+            sentence->groundSpeed = value * 1.852 / 3.6;    // knots -> m/s
+            sentence->fields |= QNmeaSentenceData::GroundSpeed;
+        }
+    }
+    if (parts.count > 8 && parts.size[8] > 0) {
+        if (qlocationutils_parseDouble(parts.data[8], parts.size[8], &value)) {
+            sentence->direction = value;
+            sentence->fields |= QNmeaSentenceData::Direction;
+        }
+    }
+    if (parts.count > 11 && parts.size[11] == 1
+            && (parts.data[11][0] == 'E' || parts.data[11][0] == 'W')) {
+        if (qlocationutils_parseDouble(parts.data[10], parts.size[10], &value)) {
+            if (parts.data[11][0] == 'W')
                 value *= -1;
-            info->setAttribute(QGeoPositionInfo::MagneticVariation, qreal(value));
+            sentence->magneticVariation = value;
+            sentence->fields |= QNmeaSentenceData::MagneticVariation;
         }
     }
+}
 
-    if (coord.type() != QGeoCoordinate::InvalidCoordinate)
-        info->setCoordinate(coord);
+static void qlocationutils_readVtg(const QNmeaSentenceFields &parts, QNmeaSentenceData *sentence, bool *hasFix)
+{
+    if (hasFix)
+        *hasFix = false;
 
-    info->setTimestamp(QDateTime(date, time, Qt::UTC));
+    double value = 0.0;
+    if (parts.count > 1 && parts.size[1] > 0) {
+        if (qlocationutils_parseDouble(parts.data[1], parts.size[1], &value)) {
+            sentence->direction = value;
+            sentence->fields |= QNmeaSentenceData::Direction;
+        }
+    }
+    if (parts.count > 7 && parts.size[7] > 0) {
+        if (qlocationutils_parseDouble(parts.data[7], parts.size[7], &value)) {
+            sentence->groundSpeed = value / 3.6;    // km/h -> m/s
+            sentence->fields |= QNmeaSentenceData::GroundSpeed;
+        }
+    }
 }
 
-static void qlocationutils_readVtg(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
+static void qlocationutils_readGsa(const QNmeaSentenceFields &parts, QNmeaSentenceData *, bool *hasFix)
+{
+    // fix mode: 1 = no fix, 2 = 2D fix, 3 = 3D fix
+    if (hasFix && parts.count > 2 && parts.size[2] > 0)
+        *hasFix = (parts.data[2][0] == '2' || parts.data[2][0] == '3');
+}
+
+static void qlocationutils_readGst(const QNmeaSentenceFields &parts, QNmeaSentenceData *sentence, bool *hasFix)
 {
     if (hasFix)
         *hasFix = false;
 
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
+    if (parts.count > 1 && parts.size[1] > 0) {
+        if (QLocationUtils::getNmeaTime(parts.data[1], parts.size[1], &sentence->time))
+            sentence->fields |= QNmeaSentenceData::Timestamp;
+    }
 
-    bool parsed = false;
-    double value = 0.0;
-    if (parts.count() > 1 && parts[1].count() > 0) {
-        value = parts[1].toDouble(&parsed);
-        if (parsed)
-            info->setAttribute(QGeoPositionInfo::Direction, qreal(value));
+    // standard deviations in meters of the latitude, longitude and altitude
+    double latitudeError = 0.0;
+    double longitudeError = 0.0;
+    if (parts.count > 7 && parts.size[6] > 0 && parts.size[7] > 0
+            && qlocationutils_parseDouble(parts.data[6], parts.size[6], &latitudeError)
+            && qlocationutils_parseDouble(parts.data[7], parts.size[7], &longitudeError)) {
+        sentence->horizontalAccuracy = sqrt(latitudeError * latitudeError + longitudeError * longitudeError);
+        sentence->fields |= QNmeaSentenceData::HorizontalAccuracy;
     }
-    if (parts.count() > 7 && parts[7].count() > 0) {
-        value = parts[7].toDouble(&parsed);
-        if (parsed)
-            info->setAttribute(QGeoPositionInfo::GroundSpeed, qreal(value / 3.6));    // km/h -> m/s
+
+    if (parts.count > 8) {
+        // the last field still holds the checksum
+        const char *asterisk = static_cast<const char *>(memchr(parts.data[8], '*', parts.size[8]));
+        int size = asterisk ? int(asterisk - parts.data[8]) : parts.size[8];
+        if (size > 0 && qlocationutils_parseDouble(parts.data[8], size, &sentence->verticalAccuracy))
+            sentence->fields |= QNmeaSentenceData::VerticalAccuracy;
     }
 }
 
-static void qlocationutils_readZda(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
+static void qlocationutils_readZda(const QNmeaSentenceFields &parts, QNmeaSentenceData *sentence, bool *hasFix)
 {
     if (hasFix)
         *hasFix = false;
 
-    QByteArray sentence(data, size);
-    QList<QByteArray> parts = sentence.split(',');
-    QDate date;
-    QTime time;
-
-    if (parts.count() > 1 && parts[1].count() > 0)
-        QLocationUtils::getNmeaTime(parts[1], &time);
+    if (parts.count > 1 && parts.size[1] > 0)
+        QLocationUtils::getNmeaTime(parts.data[1], parts.size[1], &sentence->time);
 
-    if (parts.count() > 4 && parts[2].count() > 0 && parts[3].count() > 0
-            && parts[4].count() == 4) {     // must be full 4-digit year
-        int day = parts[2].toUInt();
-        int month = parts[3].toUInt();
-        int year = parts[4].toUInt();
+    if (parts.count > 4 && parts.size[2] > 0 && parts.size[3] > 0
+            && parts.size[4] == 4) {     // must be full 4-digit year
+        int day = qlocationutils_parseUInt(parts.data[2], parts.size[2]);
+        int month = qlocationutils_parseUInt(parts.data[3], parts.size[3]);
+        int year = qlocationutils_parseUInt(parts.data[4], parts.size[4]);
         if (day > 0 && month > 0 && year > 0)
-            date.setDate(year, month, day);
+            sentence->date.setDate(year, month, day);
+    }
+
+    sentence->fields |= QNmeaSentenceData::Timestamp;
+}
+
+// Decodes a GGA, GLL, GSA, GST, RMC, VTG or ZDA sentence; returns false for anything else.
+static bool qlocationutils_readNmeaSentence(const char *data, int size, QNmeaSentenceData *sentence, bool *hasFix)
+{
+    if (size < 6 || data[0] != '$' || !QLocationUtils::hasValidNmeaChecksum(data, size))
+        return false;
+
+    void (*reader)(const QNmeaSentenceFields &, QNmeaSentenceData *, bool *) = 0;
+    if (data[3] == 'G' && data[4] == 'G' && data[5] == 'A') {
+        // "$--GGA" sentence.
+        reader = qlocationutils_readGga;
+    } else if (data[3] == 'G' && data[4] == 'L' && data[5] == 'L') {
+        // "$--GLL" sentence.
+        reader = qlocationutils_readGll;
+    } else if (data[3] == 'G' && data[4] == 'S' && data[5] == 'A') {
+        // "$--GSA" sentence.
+        reader = qlocationutils_readGsa;
+    } else if (data[3] == 'G' && data[4] == 'S' && data[5] == 'T') {
+        // "$--GST" sentence.
+        reader = qlocationutils_readGst;
+    } else if (data[3] == 'R' && data[4] == 'M' && data[5] == 'C') {
+        // "$--RMC" sentence.
+        reader = qlocationutils_readRmc;
+    } else if (data[3] == 'V' && data[4] == 'T' && data[5] == 'G') {
+        // "$--VTG" sentence.
+        reader = qlocationutils_readVtg;
+    } else if (data[3] == 'Z' && data[4] == 'D' && data[5] == 'A') {
+        // "$--ZDA" sentence.
+        reader = qlocationutils_readZda;
+    } else {
+        return false;
     }
 
-    info->setTimestamp(QDateTime(date, time, Qt::UTC));
+    QNmeaSentenceFields parts;
+    qlocationutils_splitNmeaSentence(data, size, &parts);
+    reader(parts, sentence, hasFix);
+    return true;
+}
+
+static void qlocationutils_applyNmeaData(const QNmeaSentenceData &sentence, QGeoPositionInfo *info)
+{
+    if (sentence.fields & QNmeaSentenceData::Timestamp)
+        info->setTimestamp(QDateTime(sentence.date, sentence.time, Qt::UTC));
+    if (sentence.fields & QNmeaSentenceData::Coordinate)
+        info->setCoordinate(QGeoCoordinate(sentence.latitude, sentence.longitude, sentence.altitude));
+    if (sentence.fields & QNmeaSentenceData::GroundSpeed)
+        info->setAttribute(QGeoPositionInfo::GroundSpeed, qreal(sentence.groundSpeed));
+    if (sentence.fields & QNmeaSentenceData::Direction)
+        info->setAttribute(QGeoPositionInfo::Direction, qreal(sentence.direction));
+    if (sentence.fields & QNmeaSentenceData::MagneticVariation)
+        info->setAttribute(QGeoPositionInfo::MagneticVariation, qreal(sentence.magneticVariation));
+    if (sentence.fields & QNmeaSentenceData::HorizontalAccuracy)
+        info->setAttribute(QGeoPositionInfo::HorizontalAccuracy, qreal(sentence.horizontalAccuracy));
+    if (sentence.fields & QNmeaSentenceData::VerticalAccuracy)
+        info->setAttribute(QGeoPositionInfo::VerticalAccuracy, qreal(sentence.verticalAccuracy));
+}
+
+// GSA and GST sentences describe the fix of other sentences and have no position of their own.
+static bool qlocationutils_isFixQualitySentence(const char *data, int size)
+{
+    return size >= 6 && data[3] == 'G' && data[4] == 'S' && (data[5] == 'A' || data[5] == 'T');
 }
 
 bool QLocationUtils::getPosInfoFromNmea(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
 {
-    if (!info)
+    if (!info || qlocationutils_isFixQualitySentence(data, size))
         return false;
 
     if (hasFix)
         *hasFix = false;
-    if (size < 6 || data[0] != '$' || !hasValidNmeaChecksum(data, size))
+
+    QNmeaSentenceData sentence;
+    if (!qlocationutils_readNmeaSentence(data, size, &sentence, hasFix))
         return false;
 
-    if (data[3] == 'G' && data[4] == 'G' && data[5] == 'A') {
-        // "$--GGA" sentence.
-        qlocationutils_readGga(data, size, info, hasFix);
-        return true;
+    qlocationutils_applyNmeaData(sentence, info);
+    return true;
+}
+
+bool QLocationUtils::getFixQualityFromNmea(const char *data, int size, QGeoPositionInfo *info, bool *hasFix)
+{
+    if (!info || !qlocationutils_isFixQualitySentence(data, size))
+        return false;
+
+    if (hasFix)
+        *hasFix = false;
+
+    QNmeaSentenceData sentence;
+    if (!qlocationutils_readNmeaSentence(data, size, &sentence, hasFix))
+        return false;
+
+    qlocationutils_applyNmeaData(sentence, info);
+    return true;
+}
+
+// Splits a sentence with a valid checksum into its fields, leaving the
+// checksum out of the last field.
+static bool qlocationutils_splitCheckedSentence(const char *data, int size, QNmeaSentenceFields *parts)
+{
+    if (size < 6 || data[0] != '$' || !QLocationUtils::hasValidNmeaChecksum(data, size))
+        return false;
+
+    const char *asterisk = static_cast<const char *>(memchr(data, '*', size));
+    qlocationutils_splitNmeaSentence(data, int(asterisk - data), parts);
+    return true;
+}
+
+bool QLocationUtils::getSatInfoFromNmeaGsv(const char *data, int size, QList<QGeoSatelliteInfo> *satellites,
+                                           int *sentenceNumber, int *sentenceCount)
+{
+    QNmeaSentenceFields parts;
+    if (!satellites || !qlocationutils_splitCheckedSentence(data, size, &parts)
+            || data[3] != 'G' || data[4] != 'S' || data[5] != 'V' || parts.count < 4) {
+        return false;
     }
 
-    if (data[3] == 'G' && data[4] == 'L' && data[5] == 'L') {
-        // "$--GLL" sentence.
-        qlocationutils_readGll(data, size, info, hasFix);
-        return true;
+    bool hasCount = false;
+    bool hasNumber = false;
+    int count = qlocationutils_parseUInt(parts.data[1], parts.size[1], &hasCount);
+    int number = qlocationutils_parseUInt(parts.data[2], parts.size[2], &hasNumber);
+    if (!hasCount || !hasNumber || number < 1 || number > count)
+        return false;
+
+    // up to four satellites of four fields each: PRN, elevation, azimuth, SNR
+    for (int i = 4; i + 3 < parts.count; i += 4) {
+        bool hasPrn = false;
+        int prn = qlocationutils_parseUInt(parts.data[i], parts.size[i], &hasPrn);
+        if (!hasPrn)
+            continue;
+
+        QGeoSatelliteInfo satellite;
+        satellite.setPrnNumber(prn);
+
+        double value;
+        if (parts.size[i + 1] > 0 && qlocationutils_parseDouble(parts.data[i + 1], parts.size[i + 1], &value))
+            satellite.setAttribute(QGeoSatelliteInfo::Elevation, qreal(value));
+        if (parts.size[i + 2] > 0 && qlocationutils_parseDouble(parts.data[i + 2], parts.size[i + 2], &value))
+            satellite.setAttribute(QGeoSatelliteInfo::Azimuth, qreal(value));
+
+        bool hasSignal = false;
+        int signal = qlocationutils_parseUInt(parts.data[i + 3], parts.size[i + 3], &hasSignal);
+        satellite.setSignalStrength(hasSignal ? signal : -1);
+
+        satellites->append(satellite);
     }
 
-    if (data[3] == 'R' && data[4] == 'M' && data[5] == 'C') {
-        // "$--RMC" sentence.
-        qlocationutils_readRmc(data, size, info, hasFix);
-        return true;
+    if (sentenceNumber)
+        *sentenceNumber = number;
+    if (sentenceCount)
+        *sentenceCount = count;
+    return true;
+}
+
+bool QLocationUtils::getSatInUseFromNmeaGsa(const char *data, int size, QList<int> *prnNumbers)
+{
+    QNmeaSentenceFields parts;
+    if (!prnNumbers || !qlocationutils_splitCheckedSentence(data, size, &parts)
+            || data[3] != 'G' || data[4] != 'S' || data[5] != 'A') {
+        return false;
     }
 
-    if (data[3] == 'V' && data[4] == 'T' && data[5] == 'G') {
-        // "$--VTG" sentence.
-        qlocationutils_readVtg(data, size, info, hasFix);
-        return true;
+    // fields 3 to 14 hold the PRNs of up to twelve satellites
+    for (int i = 3; i < 15 && i < parts.count; ++i) {
+        bool hasPrn = false;
+        int prn = qlocationutils_parseUInt(parts.data[i], parts.size[i], &hasPrn);
+        if (hasPrn)
+            prnNumbers->append(prn);
     }
+    return true;
+}
 
-    if (data[3] == 'Z' && data[4] == 'D' && data[5] == 'A') {
-        // "$--ZDA" sentence.
-        qlocationutils_readZda(data, size, info, hasFix);
-        return true;
+bool QLocationUtils::getNmeaTimestamp(const char *data, int size, QDate *date, QTime *time)
+{
+    QNmeaSentenceData sentence;
+    if (!qlocationutils_readNmeaSentence(data, size, &sentence, 0)
+            || !(sentence.fields & QNmeaSentenceData::Timestamp)) {
+        return false;
     }
 
-    return false;
+    *date = sentence.date;
+    *time = sentence.time;
+    return true;
+}
+
+int QLocationUtils::getPosInfoFromNmeaBuffer(const char *data, int size, NmeaFixArrays *fixes, int *bytesUsed)
+{
+    int added = 0;
+    int offset = 0;
+    while (offset < size && fixes->count < fixes->capacity) {
+        const char *start = data + offset;
+        const char *newline = static_cast<const char *>(memchr(start, '\n', size - offset));
+        int length;
+        if (newline) {
+            length = int(newline - start) + 1;
+        } else {
+            // an unterminated tail is only taken if it is a complete sentence
+            length = size - offset;
+            if (!hasValidNmeaChecksum(start, length))
+                break;
+        }
+        offset += length;
+
+        QNmeaSentenceData sentence;
+        bool hasFix = false;
+        if (!qlocationutils_readNmeaSentence(start, length, &sentence, &hasFix))
+            continue;
+
+        // as in QNmeaPositionInfoSource, sentences without a date use the last date seen
+        if (sentence.date.isValid())
+            fixes->currentDate = sentence.date;
+
+        if (!(sentence.fields & QNmeaSentenceData::Coordinate))
+            continue;
+
+        const int i = fixes->count++;
+        if (fixes->timestamps) {
+            qint64 timestamp = -1;
+            if ((sentence.fields & QNmeaSentenceData::Timestamp)
+                    && sentence.time.isValid() && fixes->currentDate.isValid()) {
+                timestamp = msecsSinceEpoch(fixes->currentDate, sentence.time);
+            }
+            fixes->timestamps[i] = timestamp;
+        }
+        if (fixes->latitudes)
+            fixes->latitudes[i] = sentence.latitude;
+        if (fixes->longitudes)
+            fixes->longitudes[i] = sentence.longitude;
+        if (fixes->altitudes)
+            fixes->altitudes[i] = sentence.altitude;
+        if (fixes->groundSpeeds)
+            fixes->groundSpeeds[i] = (sentence.fields & QNmeaSentenceData::GroundSpeed) ? sentence.groundSpeed : qQNaN();
+        if (fixes->directions)
+            fixes->directions[i] = (sentence.fields & QNmeaSentenceData::Direction) ? sentence.direction : qQNaN();
+        if (fixes->hasFix)
+            fixes->hasFix[i] = hasFix;
+        ++added;
+    }
+
+    if (bytesUsed)
+        *bytesUsed = offset;
+    return added;
 }
 
 bool QLocationUtils::hasValidNmeaChecksum(const char *data, int size)
 {
+    const uchar *bytes = reinterpret_cast<const uchar *>(data);
     int asteriskIndex = -1;
-    for (int i = 0; i < size; i++) {
-        if (data[i] == '*') {
+    uchar result = 0;
+    int i = 0;
+
+    // XOR every byte up to the '*', including the leading '$' which is
+    // taken out again below. Whole 16 byte blocks that do not contain the
+    // '*' are folded into a vector accumulator; the block holding the '*'
+    // and the tail are handled by the scalar loop.
+#if defined(QLOCATIONUTILS_NMEA_SSE2)
+    const __m128i asterisk = _mm_set1_epi8('*');
+    __m128i sum = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(block, asterisk)))
+            break;
+        sum = _mm_xor_si128(sum, block);
+    }
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 8));
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 4));
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 2));
+    sum = _mm_xor_si128(sum, _mm_srli_si128(sum, 1));
+    result = uchar(_mm_cvtsi128_si32(sum));
+#elif defined(QLOCATIONUTILS_NMEA_NEON)
+    const uint8x16_t asterisk = vdupq_n_u8('*');
+    uint8x16_t sum = vdupq_n_u8(0);
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t block = vld1q_u8(bytes + i);
+        uint8x16_t matches = vceqq_u8(block, asterisk);
+        uint8x8_t folded = vorr_u8(vget_low_u8(matches), vget_high_u8(matches));
+        if (vget_lane_u64(vreinterpret_u64_u8(folded), 0))
+            break;
+        sum = veorq_u8(sum, block);
+    }
+    uint8x8_t half = veor_u8(vget_low_u8(sum), vget_high_u8(sum));
+    quint64 lanes = vget_lane_u64(vreinterpret_u64_u8(half), 0);
+    lanes ^= lanes >> 32;
+    lanes ^= lanes >> 16;
+    lanes ^= lanes >> 8;
+    result = uchar(lanes);
+#endif
+
+    for (; i < size; i++) {
+        if (bytes[i] == '*') {
             asteriskIndex = i;
             break;
         }
+        result ^= bytes[i];
     }
 
     const int CSUM_LEN = 2;
     if (asteriskIndex < 0 || asteriskIndex + CSUM_LEN >= size)
         return false;
 
-    // XOR byte value of all characters between '$' and '*'
-    int result = 0;
-    for (int i = 1; i < asteriskIndex; i++)
-        result ^= data[i];
-    /*
-        char calc[CSUM_LEN + 1];
-        ::snprintf(calc, CSUM_LEN + 1, "%02x", result);
-        return ::strncmp(calc, &data[asteriskIndex+1], 2) == 0;
-        */
-
-    QString s;
-    s.sprintf("%02x", result);
-    // klocwork detects ABV.STACK if the following line replaces the code below:
-    //  return s.toAscii() == QByteArray(&data[asteriskIndex+1], 2);
-    if ( s.toAscii() == QByteArray(&data[asteriskIndex+1], 2) ) {
-        return true;
-    }
-    return false;
+    // the checksum covers the characters between '$' and '*'
+    if (asteriskIndex > 0)
+        result ^= bytes[0];
+
+    return (qlocationutils_hexDigitMismatch(bytes[asteriskIndex + 1], result >> 4)
+            | qlocationutils_hexDigitMismatch(bytes[asteriskIndex + 2], result & 0xf)) == 0;
 }
 
 bool QLocationUtils::getNmeaTime(const QByteArray &bytes, QTime *time)
 {
-    int dotIndex = bytes.indexOf('.');
-    QTime tempTime;
+    return getNmeaTime(bytes.constData(), bytes.size(), time);
+}
 
-    if (dotIndex < 0) {
-        tempTime = QTime::fromString(bytes, "hhmmss");
-    } else {
-        tempTime = QTime::fromString(bytes.mid(0, dotIndex), "hhmmss");
+bool QLocationUtils::getNmeaTime(const char *data, int size, QTime *time)
+{
+    const char *dot = static_cast<const char *>(memchr(data, '.', size));
+    int timeSize = dot ? int(dot - data) : size;
+    if (timeSize != 6)
+        return false;
+
+    int hour = qlocationutils_twoDigits(data);
+    int minute = qlocationutils_twoDigits(data + 2);
+    int second = qlocationutils_twoDigits(data + 4);
+    if (hour < 0 || minute < 0 || second < 0 || !QTime::isValid(hour, minute, second))
+        return false;
+
+    QTime tempTime(hour, minute, second);
+    if (dot) {
+        // at most three digits are used; note that e.g. ".5" is taken as 5 msecs
         bool hasMsecs = false;
-        int midLen = qMin(3, bytes.size() - dotIndex - 1);
-        int msecs = bytes.mid(dotIndex + 1, midLen).toUInt(&hasMsecs);
+        int msecsSize = qMin(3, size - timeSize - 1);
+        int msecs = qlocationutils_parseUInt(dot + 1, msecsSize, &hasMsecs);
         if (hasMsecs)
             tempTime = tempTime.addMSecs(msecs);
     }
 
-    if (tempTime.isValid()) {
-        *time = tempTime;
-        return true;
-    }
-    return false;
+    *time = tempTime;
+    return true;
 }
 
 bool QLocationUtils::getNmeaLatLong(const QByteArray &latString, char latDirection, const QByteArray &lngString, char lngDirection, double *lat, double *lng)
+{
+    return getNmeaLatLong(latString.constData(), latString.size(), latDirection,
+                          lngString.constData(), lngString.size(), lngDirection,
+                          lat, lng);
+}
+
+bool QLocationUtils::getNmeaLatLong(const char *latData, int latSize, char latDirection,
+                                    const char *lngData, int lngSize, char lngDirection,
+                                    double *lat, double *lng)
 {
     if ((latDirection != 'N' && latDirection != 'S')
             || (lngDirection != 'E' && lngDirection != 'W')) {
         return false;
     }
 
-    bool hasLat = false;
-    bool hasLong = false;
-    double tempLat = latString.toDouble(&hasLat);
-    double tempLng = lngString.toDouble(&hasLong);
-    if (hasLat && hasLong) {
+    double tempLat;
+    double tempLng;
+    if (qlocationutils_parseDouble(latData, latSize, &tempLat)
+            && qlocationutils_parseDouble(lngData, lngSize, &tempLng)) {
         tempLat = qlocationutils_nmeaDegreesToDecimal(tempLat);
         if (latDirection == 'S')
             tempLat *= -1;
@@ -356,4 +781,3 @@ bool QLocationUtils::getNmeaLatLong(const QByteArray &latString, char latDirecti
 }
 
 QTMS_END_NAMESPACE
-
@@ -54,14 +54,18 @@
 
 #include "qmobilitysubset.h"
 
+#include <QDate>
+#include <QTime>
+
 QT_BEGIN_NAMESPACE
-class QTime;
 class QByteArray;
+template <typename T> class QList;
 QT_END_NAMESPACE
 
 QTMS_BEGIN_NAMESPACE
 
 class QGeoPositionInfo;
+class QGeoSatelliteInfo;
 class QLocationUtils
 {
 public:
@@ -73,18 +77,109 @@ public:
     }
 
     /*
-        Creates a QGeoPositionInfo from a GGA, GLL, RMC, VTG or ZDA sentence.
+        Creates a QGeoPositionInfo from a GGA, GLL, RMC, VTG or ZDA
+        sentence. The talker ID is not checked, so the sentences of any
+        constellation ("GP", "GL", "GA", "BD", ...) or of a combined
+        solution ("GN") are read.
 
         Note:
         - GGA and GLL sentences have time but not date so the update's
           QDateTime object will have an invalid date.
         - RMC reports date with a two-digit year so in this case the year
           is assumed to be after the year 2000.
+        - Returns false for GSA and GST sentences, which have no position;
+          see getFixQualityFromNmea().
     */
     QM_AUTOTEST_EXPORT static bool getPosInfoFromNmea(const char *data, int size, QGeoPositionInfo *info, bool *hasFix = 0);
 
+    /*
+        Decodes a GSA or GST sentence, which describe a fix without reporting
+        its position, and returns false for any other sentence. GSA only sets
+        hasFix, from the fix mode; GST only sets the time and the horizontal
+        and vertical accuracy. QNmeaPositionInfoSource merges them into the
+        update of the fix they belong to.
+    */
+    QM_AUTOTEST_EXPORT static bool getFixQualityFromNmea(const char *data, int size, QGeoPositionInfo *info, bool *hasFix = 0);
+
+    /*
+        Destination for getPosInfoFromNmeaBuffer(), one array per value. The
+        arrays are owned by the caller and must each hold capacity entries;
+        any of them may be 0 if that value is not wanted.
+
+        - timestamps are in msecs since the epoch (UTC), or -1 if the fix has
+          no time or no date has been seen yet.
+        - altitudes, groundSpeeds (m/s) and directions (degrees) are NaN
+          where the sentence does not report them.
+        - currentDate is the last date seen. Sentences that only report a
+          time use it, so keep the same object across calls when decoding a
+          stream in pieces.
+    */
+    struct NmeaFixArrays
+    {
+        NmeaFixArrays()
+            : capacity(0), count(0), timestamps(0), latitudes(0), longitudes(0),
+              altitudes(0), groundSpeeds(0), directions(0), hasFix(0) {}
+
+        int capacity;
+        int count;
+        qint64 *timestamps;
+        double *latitudes;
+        double *longitudes;
+        double *altitudes;
+        double *groundSpeeds;
+        double *directions;
+        bool *hasFix;
+        QDate currentDate;
+    };
+
+    /*
+        Decodes every newline terminated sentence in the buffer and appends
+        one entry to fixes for each GGA, GLL or RMC sentence that reports a
+        coordinate. VTG and ZDA sentences are decoded too, but only ZDA has
+        an effect (through its date). No QGeoPositionInfo is created.
+
+        Stops when fixes is full. A final sentence without a newline is only
+        decoded if its checksum is valid. Returns the number of entries
+        added and, if bytesUsed is not 0, sets it to the number of bytes
+        consumed so that decoding can resume from there.
+    */
+    QM_AUTOTEST_EXPORT static int getPosInfoFromNmeaBuffer(const char *data, int size, NmeaFixArrays *fixes, int *bytesUsed = 0);
+
+    /*
+        Decodes one GSV sentence and appends the satellites it lists to
+        satellites. A group of GSV sentences lists all satellites in view;
+        sentenceNumber and sentenceCount (both optional) are set to the
+        position of this sentence in its group, counting from 1.
+        Satellites without a signal strength are given a strength of -1.
+    */
+    QM_AUTOTEST_EXPORT static bool getSatInfoFromNmeaGsv(const char *data, int size, QList<QGeoSatelliteInfo> *satellites,
+                                                         int *sentenceNumber = 0, int *sentenceCount = 0);
+
+    /*
+        Decodes one GSA sentence into the PRN numbers of the satellites that
+        were used for the fix.
+    */
+    QM_AUTOTEST_EXPORT static bool getSatInUseFromNmeaGsa(const char *data, int size, QList<int> *prnNumbers);
+
+    /*
+        Reads the date and time of a GGA, GLL, RMC or ZDA sentence. Returns
+        false if the sentence does not report a timestamp. The date is left
+        invalid for GGA and GLL, and RMC and ZDA may give an invalid date or
+        time if those fields are empty.
+    */
+    QM_AUTOTEST_EXPORT static bool getNmeaTimestamp(const char *data, int size, QDate *date, QTime *time);
+
+    /*
+        Returns the UTC date and time as msecs since the epoch, without the
+        allocation that goes with a QDateTime.
+    */
+    inline static qint64 msecsSinceEpoch(const QDate &date, const QTime &time) {
+        return (qint64(date.toJulianDay()) - 2440588) * 86400000 + QTime(0, 0).msecsTo(time);
+    }
+
     /*
         Returns true if the given NMEA sentence has a valid checksum.
+        The two checksum digits may be in upper or lower case.
     */
     QM_AUTOTEST_EXPORT static bool hasValidNmeaChecksum(const char *data, int size);
 
@@ -92,12 +187,16 @@ public:
         Returns time from a string in hhmmss or hhmmss.z+ format.
     */
     QM_AUTOTEST_EXPORT static bool getNmeaTime(const QByteArray &bytes, QTime *time);
+    QM_AUTOTEST_EXPORT static bool getNmeaTime(const char *data, int size, QTime *time);
 
     /*
         Accepts e.g. ("2734.7964", 'S', "15306.0124", 'E') and returns the
         lat-long values. Fails if lat or long fail isValidLat() or isValidLong().
     */
     QM_AUTOTEST_EXPORT static bool getNmeaLatLong(const QByteArray &latString, char latDirection, const QByteArray &lngString, char lngDirection, double *lat, double *lon);
+    QM_AUTOTEST_EXPORT static bool getNmeaLatLong(const char *latData, int latSize, char latDirection,
+                                                  const char *lngData, int lngSize, char lngDirection,
+                                                  double *lat, double *lon);
 };
 
 QTMS_END_NAMESPACE
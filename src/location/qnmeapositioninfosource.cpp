@@ -39,33 +39,87 @@
 **
 ****************************************************************************/
 #include "qnmeapositioninfosource_p.h"
+#include "qnmeasatelliteinfosource_p.h"
 #include "qlocationutils_p.h"
 
 #include <QIODevice>
+#include <QFile>
 #include <QBasicTimer>
 #include <QTimerEvent>
 #include <QTimer>
+#include <QtAlgorithms>
+
+#include <limits.h>
+#include <string.h>
 
 
 QTMS_BEGIN_NAMESPACE
 
 QNmeaRealTimeReader::QNmeaRealTimeReader(QNmeaPositionInfoSourcePrivate *sourcePrivate)
-        : QNmeaReader(sourcePrivate)
+        : QNmeaReader(sourcePrivate),
+        m_bufferUsed(0)
 {
 }
 
+/*
+    Reads everything that is available and handles each complete sentence in
+    place. Serial ports and sockets may deliver a sentence in several pieces,
+    so the incomplete tail is kept for the next call instead of being parsed
+    on its own. The buffer grows to fit the longest line seen, up to
+    MaxLineLength; a line that does not end by then is dropped and reading
+    starts again at the next '$'.
+*/
 void QNmeaRealTimeReader::readAvailableData()
 {
     QGeoPositionInfo update;
     bool hasFix = false;
 
-    char buf[1024];
-    qint64 size = m_proxy->m_device->readLine(buf, sizeof(buf));
-    while (size > 0) {
-        if (m_proxy->parsePosInfoFromNmeaData(buf, size, &update, &hasFix))
-            m_proxy->notifyNewUpdate(&update, hasFix);
-        memset(buf, 0, size);
-        size = m_proxy->m_device->readLine(buf, sizeof(buf));
+    for (;;) {
+        // the device may go away while an update is being emitted
+        QIODevice *device = m_proxy->m_device;
+        if (!device)
+            break;
+
+        if (m_bufferUsed == m_buffer.size()) {
+            if (m_buffer.size() < MaxLineLength) {
+                m_buffer.resize(qMin(m_buffer.isEmpty() ? 1024 : m_buffer.size() * 2, int(MaxLineLength)));
+            } else {
+                // a device that sends no line breaks, e.g. binary data or
+                // noise, must not make the buffer grow without bound
+                char *data = m_buffer.data();
+                const char *dollar = static_cast<const char *>(memchr(data + 1, '$', m_bufferUsed - 1));
+                if (dollar) {
+                    m_bufferUsed -= int(dollar - data);
+                    memmove(data, dollar, m_bufferUsed);
+                } else {
+                    m_bufferUsed = 0;
+                }
+            }
+        }
+
+        qint64 size = device->read(m_buffer.data() + m_bufferUsed, m_buffer.size() - m_bufferUsed);
+        if (size <= 0)
+            break;
+
+        // only the new data can hold the end of the kept sentence
+        char *data = m_buffer.data();
+        const char *scan = data + m_bufferUsed;
+        const char *start = data;
+        const char *end = scan + size;
+        m_bufferUsed += int(size);
+
+        const char *newline;
+        while ((newline = static_cast<const char *>(memchr(scan, '\n', end - scan))) != 0) {
+            m_proxy->processNmeaSentence(start, int(newline - start) + 1);
+            while (m_proxy->takeCompletedUpdate(&update, &hasFix))
+                m_proxy->notifyNewUpdate(&update, hasFix);
+            start = scan = newline + 1;
+        }
+
+        if (start != data) {
+            m_bufferUsed = int(end - start);
+            memmove(data, start, m_bufferUsed);
+        }
     }
 }
 
@@ -75,7 +129,14 @@ void QNmeaRealTimeReader::readAvailableData()
 QNmeaSimulatedReader::QNmeaSimulatedReader(QNmeaPositionInfoSourcePrivate *sourcePrivate)
         : QNmeaReader(sourcePrivate),
         m_currTimerId(-1),
-        m_hasValidDateTime(false)
+        m_hasValidDateTime(false),
+        m_mapAttempted(false),
+        m_mappedFile(0),
+        m_map(0),
+        m_mapSize(0),
+        m_mapPos(0),
+        m_readingPastMap(false),
+        m_indexedTo(0)
 {
 }
 
@@ -83,6 +144,10 @@ QNmeaSimulatedReader::~QNmeaSimulatedReader()
 {
     if (m_currTimerId > 0)
         killTimer(m_currTimerId);
+
+    // the file unmaps by itself when it is closed or destroyed
+    if (m_map && m_proxy->m_device == m_mappedFile && m_mappedFile->isOpen())
+        m_mappedFile->unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_map)));
 }
 
 void QNmeaSimulatedReader::readAvailableData()
@@ -93,6 +158,11 @@ void QNmeaSimulatedReader::readAvailableData()
     if (!m_hasValidDateTime) {      // first update
         Q_ASSERT(m_proxy->m_device && (m_proxy->m_device->openMode() & QIODevice::ReadOnly));
 
+        if (!m_mapAttempted) {
+            m_mapAttempted = true;
+            mapDevice();
+        }
+
         if (!setFirstDateTime()) {
             //m_proxy->notifyReachedEndOfFile();
             qWarning("QNmeaPositionInfoSource: cannot find NMEA sentence with valid date & time");
@@ -108,18 +178,159 @@ void QNmeaSimulatedReader::readAvailableData()
     }
 }
 
+/*
+    Maps a file backed device into memory, so that sentences are read in place
+    instead of being copied out one line at a time by QIODevice::readLine().
+    Devices that are not files, or files that cannot be mapped (for example
+    a multi-gigabyte file in a 32 bit address space), are read as before.
+*/
+void QNmeaSimulatedReader::mapDevice()
+{
+    QFile *file = qobject_cast<QFile *>(m_proxy->m_device);
+    if (!file || file->isSequential())
+        return;
+
+    qint64 size = file->size();
+    qint64 pos = file->pos();
+    if (size <= 0 || pos >= size)
+        return;
+
+    uchar *map = file->map(0, size);
+    if (!map)
+        return;
+
+    m_mappedFile = file;
+    m_map = reinterpret_cast<const char *>(map);
+    m_mapSize = size;
+    m_mapPos = pos;
+    m_indexedTo = pos;
+}
+
+/*
+    Adds the sentence at m_indexedTo to the sentence index, which records the
+    offset of the first sentence of each epoch, and moves past it. Only
+    sentences the standard parser understands are indexed, and an entry is
+    only added when the timestamp moves forward so that the index stays
+    sorted.
+*/
+void QNmeaSimulatedReader::indexSentence(const char *sentence, qint64 size)
+{
+    QDate date;
+    QTime time;
+    if (size <= INT_MAX && QLocationUtils::getNmeaTimestamp(sentence, int(size), &date, &time)) {
+        if (date.isValid())
+            m_indexDate = date;
+        if (time.isValid() && m_indexDate.isValid()) {
+            qint64 timestamp = QLocationUtils::msecsSinceEpoch(m_indexDate, time);
+            if (m_sentenceIndex.isEmpty() || timestamp > m_sentenceIndex.last().timestamp) {
+                QNmeaSentenceOffset entry;
+                entry.offset = m_indexedTo;
+                entry.timestamp = timestamp;
+                m_sentenceIndex.append(entry);
+            }
+        }
+    }
+
+    m_indexedTo += size;
+}
+
+/*
+    Indexes the mapping beyond what has been read until an epoch at or after
+    \a timestamp is found, or the whole mapping is indexed. Returns false if
+    there is no such epoch.
+*/
+bool QNmeaSimulatedReader::indexUntil(qint64 timestamp)
+{
+    while (m_sentenceIndex.isEmpty() || m_sentenceIndex.last().timestamp < timestamp) {
+        if (m_indexedTo >= m_mapSize)
+            return false;
+
+        const char *start = m_map + m_indexedTo;
+        const char *newline = static_cast<const char *>(memchr(start, '\n', size_t(m_mapSize - m_indexedTo)));
+        indexSentence(start, newline ? (newline - start) + 1 : m_mapSize - m_indexedTo);
+    }
+    return true;
+}
+
+/*
+    Returns the next line of data in \a sentence and its length in \a size,
+    which may be 0 or less if the device could not be read. Returns false if
+    no more data is available.
+*/
+bool QNmeaSimulatedReader::readSentence(const char **sentence, qint64 *size)
+{
+    if (m_map) {
+        // the mapping goes away if the device is closed or destroyed
+        if (m_proxy->m_device == m_mappedFile && m_mappedFile->isOpen()) {
+            if (m_mapPos < m_mapSize) {
+                const char *start = m_map + m_mapPos;
+                const char *newline = static_cast<const char *>(memchr(start, '\n', size_t(m_mapSize - m_mapPos)));
+                *size = newline ? (newline - start) + 1 : m_mapSize - m_mapPos;
+                *sentence = start;
+
+                // the index grows as the data is read for the first time
+                if (m_mapPos == m_indexedTo)
+                    indexSentence(start, *size);
+
+                m_mapPos += *size;
+                return true;
+            }
+
+            // anything appended after the file was mapped is read from the
+            // device. The mapping is kept, so that seek() can go back into it.
+            if (!m_readingPastMap) {
+                m_mappedFile->seek(m_mapSize);
+                m_readingPastMap = true;
+            }
+        } else {
+            m_map = 0;
+        }
+    }
+
+    if (!m_proxy->m_device || m_proxy->m_device->bytesAvailable() <= 0)
+        return false;
+
+    *size = m_proxy->m_device->readLine(m_lineBuffer, sizeof(m_lineBuffer));
+    *sentence = m_lineBuffer;
+    return true;
+}
+
+// Reads sentences until the next epoch is complete. At the end of a file the
+// last epoch is complete too, since no sentence will follow it.
+bool QNmeaSimulatedReader::readUpdate(QGeoPositionInfo *update, bool *hasFix)
+{
+    const char *sentence;
+    qint64 size;
+    while (!m_proxy->takeCompletedUpdate(update, hasFix)) {
+        if (!readSentence(&sentence, &size)) {
+            QIODevice *device = m_proxy->m_device;
+            if (!device || device->isSequential() || !device->atEnd())
+                return false;
+            m_proxy->completeEpoch();
+            return m_proxy->takeCompletedUpdate(update, hasFix);
+        }
+        if (size > 0)
+            m_proxy->processNmeaSentence(sentence, size);
+    }
+    return true;
+}
+
 bool QNmeaSimulatedReader::setFirstDateTime()
 {
-    // find the first update with valid date and time
+    // find the first update with valid date and time. The sentences are read
+    // one by one rather than skipped with the sentence index, which is built
+    // with the standard parser and would pass over sentences that a
+    // reimplemented parsePosInfoFromNmeaData() accepts.
     QGeoPositionInfo update;
     bool hasFix = false;
-    while (m_proxy->m_device->bytesAvailable() > 0) {
-        char buf[1024];
-        qint64 size = m_proxy->m_device->readLine(buf, sizeof(buf));
-        if (size <= 0)
-            continue;
-        bool ok = m_proxy->parsePosInfoFromNmeaData(buf, size, &update, &hasFix);
-        if (ok && update.timestamp().isValid()) {
+    while (readUpdate(&update, &hasFix)) {
+        if (m_seekDate.isValid() && !update.timestamp().date().isValid()
+                && update.timestamp().time().isValid()) {
+            // after a seek the date comes from the index
+            update.setTimestamp(QDateTime(m_seekDate, update.timestamp().time(), Qt::UTC));
+        }
+        if (update.timestamp().isValid()) {
+            m_seekDate = QDate();
             QPendingGeoPositionInfo pending;
             pending.info = update;
             pending.hasFix = hasFix;
@@ -130,6 +341,63 @@ bool QNmeaSimulatedReader::setFirstDateTime()
     return false;
 }
 
+static bool qnmeapositioninfosource_timestampLessThan(const QNmeaSentenceOffset &a, const QNmeaSentenceOffset &b)
+{
+    return a.timestamp < b.timestamp;
+}
+
+/*
+    Moves playback to the first epoch at or after \a dateTime, looking it up
+    in the sentence index. The part of the mapping that has not been read yet
+    is only indexed as far as needed. Only memory mapped files can be
+    seek()ed.
+*/
+bool QNmeaSimulatedReader::seek(const QDateTime &dateTime)
+{
+    if (!m_mapAttempted) {
+        m_mapAttempted = true;
+        mapDevice();
+    }
+
+    // the mapping goes away if the device is closed or destroyed
+    if (m_map && (m_proxy->m_device != m_mappedFile || !m_mappedFile->isOpen()))
+        m_map = 0;
+
+    if (!m_map || !dateTime.isValid())
+        return false;
+
+    QNmeaSentenceOffset target;
+    target.offset = 0;
+    target.timestamp = dateTime.toMSecsSinceEpoch();
+    if (!indexUntil(target.timestamp))
+        return false;
+
+    QVector<QNmeaSentenceOffset>::const_iterator it = qLowerBound(m_sentenceIndex.constBegin(),
+                                                                  m_sentenceIndex.constEnd(),
+                                                                  target,
+                                                                  qnmeapositioninfosource_timestampLessThan);
+    if (it == m_sentenceIndex.constEnd())
+        return false;
+
+    if (m_currTimerId > 0) {
+        killTimer(m_currTimerId);
+        m_currTimerId = -1;
+    }
+    m_pendingUpdates.clear();
+    m_hasValidDateTime = false;
+    m_proxy->resetEpoch();
+
+    m_mapPos = it->offset;
+    m_readingPastMap = false;
+    m_seekDate = QDateTime::fromMSecsSinceEpoch(it->timestamp).toUTC().date();
+    m_proxy->m_currentDate = m_seekDate;
+
+    // playback continues from the new position once updates are started
+    if (m_proxy->isActive())
+        readAvailableData();
+    return true;
+}
+
 void QNmeaSimulatedReader::simulatePendingUpdate()
 {
     if (m_pendingUpdates.size() > 0) {
@@ -160,22 +428,16 @@ void QNmeaSimulatedReader::processNextSentence()
 
     // find the next update with a valid time (as long as the time is valid,
     // we can calculate when the update should be emitted)
-    while (m_proxy->m_device && m_proxy->m_device->bytesAvailable() > 0) {
-        char buf[1024];
-        qint64 size = m_proxy->m_device->readLine(buf, sizeof(buf));
-        if (size <= 0)
-            continue;
-        if (m_proxy->parsePosInfoFromNmeaData(buf, size, &info, &hasFix)) {
-            QTime time = info.timestamp().time();
-            if (time.isValid()) {
-                if (!prevTime.isValid()) {
-                    timeToNextUpdate = 0;
-                    break;
-                }
-                timeToNextUpdate = prevTime.msecsTo(time);
-                if (timeToNextUpdate >= 0)
-                    break;
+    while (readUpdate(&info, &hasFix)) {
+        QTime time = info.timestamp().time();
+        if (time.isValid()) {
+            if (!prevTime.isValid()) {
+                timeToNextUpdate = 0;
+                break;
             }
+            timeToNextUpdate = prevTime.msecsTo(time);
+            if (timeToNextUpdate >= 0)
+                break;
         }
     }
 
@@ -188,7 +450,10 @@ void QNmeaSimulatedReader::processNextSentence()
     pending.info = info;
     pending.hasFix = hasFix;
     m_pendingUpdates.enqueue(pending);
-    m_currTimerId = startTimer(timeToNextUpdate);
+
+    // a playback rate of 0 replays as fast as the event loop allows
+    qreal rate = m_proxy->m_playbackRate;
+    m_currTimerId = startTimer(rate > 0 ? qRound(timeToNextUpdate / rate) : 0);
 }
 
 
@@ -197,6 +462,7 @@ void QNmeaSimulatedReader::processNextSentence()
 
 QNmeaPositionInfoSourcePrivate::QNmeaPositionInfoSourcePrivate(QNmeaPositionInfoSource *parent)
         : QObject(parent),
+        m_playbackRate(1.0),
         m_invokedStart(false),
         m_source(parent),
         m_nmeaReader(0),
@@ -204,12 +470,20 @@ QNmeaPositionInfoSourcePrivate::QNmeaPositionInfoSourcePrivate(QNmeaPositionInfo
         m_requestTimer(0),
         m_noUpdateLastInterval(false),
         m_updateTimeoutSent(false),
-        m_connectedReadyRead(false)
+        m_connectedReadyRead(false),
+        m_epochHasFix(false),
+        m_epochHasGsa(false),
+        m_epochGsaHasFix(false)
 {
+    memset(m_lastSentenceId, 0, sizeof(m_lastSentenceId));
+    memset(m_epochEndId, 0, sizeof(m_epochEndId));
 }
 
 QNmeaPositionInfoSourcePrivate::~QNmeaPositionInfoSourcePrivate()
 {
+    for (int i = 0; i < m_satelliteSources.count(); ++i)
+        m_satelliteSources.at(i)->m_positionSource = 0;
+
     delete m_nmeaReader;
     delete m_updateTimer;
 }
@@ -275,10 +549,134 @@ void QNmeaPositionInfoSourcePrivate::prepareSourceDevice()
     }
 }
 
-bool QNmeaPositionInfoSourcePrivate::parsePosInfoFromNmeaData(const char *data, int size,
-        QGeoPositionInfo *posInfo, bool *hasFix)
+/*
+    Parses one sentence into the current epoch, the updates that share a UTC
+    time. The epoch is complete when a sentence with another time is read, or
+    as soon as the kind of sentence with a time (RMC, GGA, GLL or ZDA) that
+    ended the previous epoch is read, so a receiver that sends a burst of RMC,
+    GGA, VTG, GSA and GST sentences per fix produces a single update per fix.
+    GSA sentences, which multi-constellation receivers send once per
+    constellation, only reject the fix if none of them reports one.
+    Completed epochs are collected with takeCompletedUpdate().
+*/
+void QNmeaPositionInfoSourcePrivate::processNmeaSentence(const char *data, int size)
 {
-    return m_source->parsePosInfoFromNmeaData(data, size, posInfo, hasFix);
+    // satellite sources see every sentence in the same pass
+    for (int i = 0; i < m_satelliteSources.count(); ++i)
+        m_satelliteSources.at(i)->processNmeaSentence(data, size);
+
+    QGeoPositionInfo update;
+    bool hasFix = false;
+    bool isGsa = false;
+    if (!m_source->parsePosInfoFromNmeaData(data, size, &update, &hasFix)) {
+        // GSA and GST only add the fix mode and the accuracy to the epoch
+        if (!QLocationUtils::getFixQualityFromNmea(data, size, &update, &hasFix))
+            return;
+        isGsa = (data[5] == 'A');
+    }
+
+    QTime time = update.timestamp().time();
+    QTime epochTime = m_epochUpdate.timestamp().time();
+    if (time.isValid() && epochTime.isValid() && time != epochTime) {
+        memcpy(m_epochEndId, m_lastSentenceId, sizeof(m_epochEndId));
+        completeEpoch();
+    }
+
+    mergeIntoEpoch(update);
+    if (isGsa) {
+        m_epochHasGsa = true;
+        m_epochGsaHasFix = m_epochGsaHasFix || hasFix;
+    } else {
+        m_epochHasFix = m_epochHasFix || hasFix;
+    }
+
+    // GSA, GST and VTG may repeat or be left out within an epoch, so only the
+    // sentences that carry the time of the fix mark its end
+    if (!isEpochTimeSentence(data, size))
+        return;
+
+    memcpy(m_lastSentenceId, data + 1, sizeof(m_lastSentenceId));
+    if (m_epochEndId[0] && m_epochUpdate.timestamp().time().isValid()
+            && memcmp(m_lastSentenceId, m_epochEndId, sizeof(m_epochEndId)) == 0) {
+        completeEpoch();
+    }
+}
+
+bool QNmeaPositionInfoSourcePrivate::isEpochTimeSentence(const char *data, int size)
+{
+    if (size < 6)
+        return false;
+
+    const char *type = data + 3;
+    return (type[0] == 'R' && type[1] == 'M' && type[2] == 'C')
+           || (type[0] == 'G' && type[1] == 'G' && type[2] == 'A')
+           || (type[0] == 'G' && type[1] == 'L' && type[2] == 'L')
+           || (type[0] == 'Z' && type[1] == 'D' && type[2] == 'A');
+}
+
+void QNmeaPositionInfoSourcePrivate::mergeIntoEpoch(const QGeoPositionInfo &update)
+{
+    // a date is only replaced by another date
+    QDateTime timestamp = update.timestamp();
+    if (timestamp.date().isValid()
+            || (timestamp.time().isValid() && !m_epochUpdate.timestamp().date().isValid())) {
+        m_epochUpdate.setTimestamp(timestamp);
+    }
+
+    // e.g. RMC has no altitude, so the altitude of GGA is kept
+    QGeoCoordinate coordinate = update.coordinate();
+    if (coordinate.isValid()) {
+        QGeoCoordinate epochCoordinate = m_epochUpdate.coordinate();
+        if (coordinate.type() != QGeoCoordinate::Coordinate3D
+                && epochCoordinate.type() == QGeoCoordinate::Coordinate3D) {
+            coordinate.setAltitude(epochCoordinate.altitude());
+        }
+        m_epochUpdate.setCoordinate(coordinate);
+    }
+
+    for (int i = QGeoPositionInfo::Direction; i <= QGeoPositionInfo::VerticalAccuracy; ++i) {
+        QGeoPositionInfo::Attribute attribute = QGeoPositionInfo::Attribute(i);
+        if (update.hasAttribute(attribute))
+            m_epochUpdate.setAttribute(attribute, update.attribute(attribute));
+    }
+}
+
+// Queues the current epoch, if it has a time, and starts a new one.
+void QNmeaPositionInfoSourcePrivate::completeEpoch()
+{
+    if (m_epochUpdate.timestamp().time().isValid()) {
+        QPendingGeoPositionInfo completed;
+        completed.info = m_epochUpdate;
+        completed.hasFix = m_epochHasFix && (!m_epochHasGsa || m_epochGsaHasFix);
+        m_completedUpdates.enqueue(completed);
+    }
+
+    m_epochUpdate = QGeoPositionInfo();
+    m_epochHasFix = false;
+    m_epochHasGsa = false;
+    m_epochGsaHasFix = false;
+}
+
+// Drops the current epoch and any completed ones, e.g. after a seek.
+void QNmeaPositionInfoSourcePrivate::resetEpoch()
+{
+    m_epochUpdate = QGeoPositionInfo();
+    m_epochHasFix = false;
+    m_epochHasGsa = false;
+    m_epochGsaHasFix = false;
+    memset(m_lastSentenceId, 0, sizeof(m_lastSentenceId));
+    m_completedUpdates.clear();
+}
+
+bool QNmeaPositionInfoSourcePrivate::takeCompletedUpdate(QGeoPositionInfo *update, bool *hasFix)
+{
+    if (m_completedUpdates.isEmpty())
+        return false;
+
+    QPendingGeoPositionInfo completed = m_completedUpdates.dequeue();
+    *update = completed.info;
+    *hasFix = completed.hasFix;
+    return true;
 }
 
 void QNmeaPositionInfoSourcePrivate::startUpdates()
@@ -353,6 +751,38 @@ void QNmeaPositionInfoSourcePrivate::requestUpdate(int msec)
         prepareSourceDevice();
 }
 
+bool QNmeaPositionInfoSourcePrivate::seek(const QDateTime &dateTime)
+{
+    if (m_updateMode != QNmeaPositionInfoSource::SimulationMode || !initialize())
+        return false;
+
+    return static_cast<QNmeaSimulatedReader *>(m_nmeaReader)->seek(dateTime);
+}
+
+// Returns true if updates are wanted, either regularly or for a single request,
+// by this source or by a satellite source that shares its device.
+bool QNmeaPositionInfoSourcePrivate::isActive() const
+{
+    if (m_invokedStart || (m_requestTimer && m_requestTimer->isActive()))
+        return true;
+
+    for (int i = 0; i < m_satelliteSources.count(); ++i) {
+        if (m_satelliteSources.at(i)->isActive())
+            return true;
+    }
+    return false;
+}
+
+// Reads the device without starting position updates, for satellite sources.
+bool QNmeaPositionInfoSourcePrivate::startReading()
+{
+    if (!initialize())
+        return false;
+
+    prepareSourceDevice();
+    return true;
+}
+
 void QNmeaPositionInfoSourcePrivate::updateRequestTimeout()
 {
     m_requestTimer->stop();
@@ -455,6 +885,14 @@ void QNmeaPositionInfoSourcePrivate::emitUpdated(const QGeoPositionInfo &update)
 
     In both cases the position information is received via the positionUpdated() signal and the
     last known position can be accessed with lastKnownPosition().
+
+    Receivers send several sentences for each fix, often from more than one
+    constellation (for example \c $GNRMC, \c $GNGGA and \c $GNGST). The
+    sentences that share a UTC time are merged into a single update: the
+    speed and direction come from RMC or VTG, the altitude from GGA and the
+    accuracy from GST, and a GSA sentence that reports no fix marks the
+    update as having no fix. The update is emitted once the last sentence of
+    the fix has been read.
 */
 
 
@@ -507,6 +945,23 @@ bool QNmeaPositionInfoSource::parsePosInfoFromNmeaData(const char *data, int siz
     return QLocationUtils::getPosInfoFromNmea(data, size, posInfo, hasFix);
 }
 
+/*!
+    Returns true if the NMEA sentence of \a size bytes at \a data has a valid
+    checksum, that is, if the two hex digits following the '*' match the XOR
+    of all characters between the leading '$' and the '*'. The checksum digits
+    may be in upper or lower case.
+
+    This does not allocate memory, so it is suitable for use in a
+    reimplementation of parsePosInfoFromNmeaData() that handles non-standard
+    sentences.
+
+    \since 1.2
+*/
+bool QNmeaPositionInfoSource::hasValidNmeaChecksum(const char *data, int size)
+{
+    return QLocationUtils::hasValidNmeaChecksum(data, size);
+}
+
 /*!
     Returns the update mode.
 */
@@ -560,6 +1015,51 @@ void QNmeaPositionInfoSource::setUpdateInterval(int msec)
     }
 }
 
+/*!
+    \property QNmeaPositionInfoSource::playbackRate
+    \brief the speed at which recorded data is replayed in SimulationMode.
+
+    The delay between two updates is the time between them in the NMEA data
+    divided by this rate, so a rate of 10 replays a recording ten times
+    faster than it was recorded. A rate of 0 replays the data as fast as
+    possible, while still returning to the event loop between updates.
+
+    The default rate is 1. The rate has no effect in RealTimeMode.
+
+    \since 1.2
+*/
+void QNmeaPositionInfoSource::setPlaybackRate(qreal rate)
+{
+    d->m_playbackRate = qMax(qreal(0), rate);
+}
+
+qreal QNmeaPositionInfoSource::playbackRate() const
+{
+    return d->m_playbackRate;
+}
+
+/*!
+    Moves playback in SimulationMode to the first update at or after
+    \a dateTime. If updates have been started, replay continues from there
+    immediately; otherwise it begins there when they are started.
+
+    Seeking uses an index of sentence timestamps. The index is built as the
+    data is replayed, and a seek beyond the part that has been replayed
+    indexes the rest of the data only as far as \a dateTime. Seeking is only
+    supported when the device is a QFile that can be mapped into memory, and
+    remains possible after replay has reached the end of the data. Only
+    sentences that the standard parser recognizes are indexed.
+
+    Returns false if the source is not in SimulationMode, the device does not
+    support seeking, or there is no data at or after \a dateTime.
+
+    \since 1.2
+*/
+bool QNmeaPositionInfoSource::seek(const QDateTime &dateTime)
+{
+    return d->seek(dateTime);
+}
+
 /*!
     \reimp
 */
@@ -56,11 +56,15 @@
 #include "qgeopositioninfo.h"
 
 #include <QObject>
+#include <QByteArray>
 #include <QQueue>
+#include <QList>
 #include <QPointer>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QBasicTimer;
+class QFile;
 class QTimerEvent;
 class QTimer;
 QT_END_NAMESPACE
@@ -70,11 +74,18 @@ QT_BEGIN_HEADER
 QTMS_BEGIN_NAMESPACE
 
 class QNmeaReader;
+class QNmeaSatelliteInfoSourcePrivate;
 struct QPendingGeoPositionInfo {
     QGeoPositionInfo info;
     bool hasFix;
 };
 
+// Offset of the first sentence of an epoch in a memory mapped NMEA file.
+struct QNmeaSentenceOffset {
+    qint64 offset;
+    qint64 timestamp;   // msecs since the epoch, UTC
+};
+
 
 class QNmeaPositionInfoSourcePrivate : public QObject
 {
@@ -86,19 +97,27 @@ public:
     void startUpdates();
     void stopUpdates();
     void requestUpdate(int msec);
+    bool seek(const QDateTime &dateTime);
+    bool isActive() const;
+    bool startReading();
 
-    bool parsePosInfoFromNmeaData(const char *data,
-                                  int size,
-                                  QGeoPositionInfo *posInfo,
-                                  bool *hasFix);
+    void processNmeaSentence(const char *data, int size);
+    bool takeCompletedUpdate(QGeoPositionInfo *update, bool *hasFix);
+    void completeEpoch();
+    void resetEpoch();
 
     void notifyNewUpdate(QGeoPositionInfo *update, bool fixStatus);
 
     QNmeaPositionInfoSource::UpdateMode m_updateMode;
     QPointer<QIODevice> m_device;
     QGeoPositionInfo m_lastUpdate;
+    QDate m_currentDate;
+    qreal m_playbackRate;
     bool m_invokedStart;
 
+    // satellite sources that are fed from the same device
+    QList<QNmeaSatelliteInfoSourcePrivate *> m_satelliteSources;
+
 public Q_SLOTS:
     void readyRead();
 
@@ -116,15 +135,26 @@ private:
     void prepareSourceDevice();
     void emitUpdated(const QGeoPositionInfo &update);
 
+    void mergeIntoEpoch(const QGeoPositionInfo &update);
+    static bool isEpochTimeSentence(const char *data, int size);
+
     QNmeaPositionInfoSource *m_source;
     QNmeaReader *m_nmeaReader;
     QBasicTimer *m_updateTimer;
     QGeoPositionInfo m_pendingUpdate;
-    QDate m_currentDate;
     QTimer *m_requestTimer;
     bool m_noUpdateLastInterval;
     bool m_updateTimeoutSent;
     bool m_connectedReadyRead;
+
+    // sentences that share a UTC time are merged into a single update
+    QGeoPositionInfo m_epochUpdate;
+    bool m_epochHasFix;
+    bool m_epochHasGsa;         // a GSA sentence reported the fix mode
+    bool m_epochGsaHasFix;      // a GSA sentence reported a 2D or 3D fix
+    char m_lastSentenceId[5];   // the last sentence with a time, e.g. "GNRMC"
+    char m_epochEndId[5];       // the last sentence with a time of the previous epoch
+    QQueue<QPendingGeoPositionInfo> m_completedUpdates;
 };
 
 
@@ -147,6 +177,15 @@ class QNmeaRealTimeReader : public QNmeaReader
 public:
     explicit QNmeaRealTimeReader(QNmeaPositionInfoSourcePrivate *sourcePrivate);
     virtual void readAvailableData();
+
+private:
+    // NMEA 0183 limits sentences to 82 characters; a longer line is noise
+    enum { MaxLineLength = 4096 };
+
+    // the start of a sentence that has not been received completely is kept
+    // at the front of the buffer until the rest arrives
+    QByteArray m_buffer;
+    int m_bufferUsed;
 };
 
 
@@ -157,6 +196,7 @@ public:
     explicit QNmeaSimulatedReader(QNmeaPositionInfoSourcePrivate *sourcePrivate);
     ~QNmeaSimulatedReader();
     virtual void readAvailableData();
+    bool seek(const QDateTime &dateTime);
 
 protected:
     virtual void timerEvent(QTimerEvent *event);
@@ -166,11 +206,31 @@ private Q_SLOTS:
 
 private:
     bool setFirstDateTime();
+    bool readUpdate(QGeoPositionInfo *update, bool *hasFix);
     void processNextSentence();
+    void mapDevice();
+    void indexSentence(const char *sentence, qint64 size);
+    bool indexUntil(qint64 timestamp);
+    bool readSentence(const char **sentence, qint64 *size);
 
     QQueue<QPendingGeoPositionInfo> m_pendingUpdates;
     int m_currTimerId;
     bool m_hasValidDateTime;
+
+    // file backed devices are replayed from a memory mapping
+    bool m_mapAttempted;
+    QFile *m_mappedFile;
+    const char *m_map;
+    qint64 m_mapSize;
+    qint64 m_mapPos;
+    bool m_readingPastMap;      // reading data appended after the mapping
+
+    // built as the mapping is read, and by seek() beyond what has been read
+    QVector<QNmeaSentenceOffset> m_sentenceIndex;
+    qint64 m_indexedTo;
+    QDate m_indexDate;
+    QDate m_seekDate;
+    char m_lineBuffer[1024];
 };
 
 QTMS_END_NAMESPACE
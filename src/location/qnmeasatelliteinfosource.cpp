@@ -0,0 +1,340 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qnmeasatelliteinfosource_p.h"
+#include "qnmeapositioninfosource_p.h"
+#include "qlocationutils_p.h"
+
+#include <QTimer>
+
+
+QTMS_BEGIN_NAMESPACE
+
+QNmeaSatelliteInfoSourcePrivate::QNmeaSatelliteInfoSourcePrivate(QNmeaSatelliteInfoSource *parent,
+                                                                 QNmeaPositionInfoSource *positionSource)
+        : QObject(parent),
+        m_positionSource(positionSource),
+        m_source(parent),
+        m_lastGsvSentence(0),
+        m_gsvRunComplete(false),
+        m_inGsvRun(false),
+        m_inGsaRun(false),
+        m_requestTimer(0),
+        m_requestPending(false),
+        m_invokedStart(false)
+{
+    m_gsvTalker[0] = m_gsvTalker[1] = 0;
+    if (m_positionSource)
+        m_positionSource->d->m_satelliteSources.append(this);
+}
+
+QNmeaSatelliteInfoSourcePrivate::~QNmeaSatelliteInfoSourcePrivate()
+{
+    if (m_positionSource)
+        m_positionSource->d->m_satelliteSources.removeAll(this);
+}
+
+bool QNmeaSatelliteInfoSourcePrivate::startReading()
+{
+    if (!m_positionSource) {
+        qWarning("QNmeaSatelliteInfoSource: no QNmeaPositionInfoSource to read from");
+        return false;
+    }
+    return m_positionSource->d->startReading();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::startUpdates()
+{
+    if (m_invokedStart)
+        return;
+
+    m_invokedStart = true;
+    startReading();
+}
+
+void QNmeaSatelliteInfoSourcePrivate::stopUpdates()
+{
+    m_invokedStart = false;
+}
+
+void QNmeaSatelliteInfoSourcePrivate::requestUpdate(int msec)
+{
+    if (m_requestPending)
+        return;
+
+    if (msec < 0 || !startReading()) {
+        Q_EMIT m_source->requestTimeout();
+        return;
+    }
+
+    m_requestPending = true;
+    if (msec > 0) {
+        if (!m_requestTimer) {
+            m_requestTimer = new QTimer(this);
+            m_requestTimer->setSingleShot(true);
+            connect(m_requestTimer, SIGNAL(timeout()), SLOT(updateRequestTimeout()));
+        }
+        m_requestTimer->start(msec);
+    }
+}
+
+bool QNmeaSatelliteInfoSourcePrivate::isActive() const
+{
+    return m_invokedStart || m_requestPending;
+}
+
+void QNmeaSatelliteInfoSourcePrivate::updateRequestTimeout()
+{
+    m_requestPending = false;
+    Q_EMIT m_source->requestTimeout();
+}
+
+/*
+    Receivers send one GSV group and one GSA sentence per constellation, one
+    after the other. The sentences of such a run are collected and published
+    together when the first sentence of another kind is read, so there is a
+    single update per fix whatever the number of constellations.
+*/
+void QNmeaSatelliteInfoSourcePrivate::processNmeaSentence(const char *data, int size)
+{
+    bool isSatelliteSentence = size >= 6 && data[3] == 'G' && data[4] == 'S';
+    bool isGsv = isSatelliteSentence && data[5] == 'V';
+    bool isGsa = isSatelliteSentence && data[5] == 'A';
+
+    if (!isGsv && m_inGsvRun)
+        finishGsvRun();
+    if (!isGsa && m_inGsaRun)
+        finishGsaRun();
+
+    if (isGsv)
+        readGsv(data, size);
+    else if (isGsa)
+        readGsa(data, size);
+}
+
+void QNmeaSatelliteInfoSourcePrivate::readGsv(const char *data, int size)
+{
+    int sentence = 0;
+    int sentenceCount = 0;
+    QList<QGeoSatelliteInfo> satellites;
+    if (!QLocationUtils::getSatInfoFromNmeaGsv(data, size, &satellites, &sentence, &sentenceCount))
+        return;
+
+    m_inGsvRun = true;
+
+    // a group that misses a sentence is dropped as a whole
+    if (sentence == 1) {
+        m_gsvGroup.clear();
+    } else if (sentence != m_lastGsvSentence + 1
+               || data[1] != m_gsvTalker[0] || data[2] != m_gsvTalker[1]) {
+        m_gsvGroup.clear();
+        m_lastGsvSentence = 0;
+        return;
+    }
+
+    m_gsvTalker[0] = data[1];
+    m_gsvTalker[1] = data[2];
+    m_gsvGroup += satellites;
+    m_lastGsvSentence = sentence;
+    if (sentence == sentenceCount) {
+        m_gsvRun += m_gsvGroup;
+        m_gsvGroup.clear();
+        m_lastGsvSentence = 0;
+        m_gsvRunComplete = true;
+    }
+}
+
+void QNmeaSatelliteInfoSourcePrivate::readGsa(const char *data, int size)
+{
+    if (QLocationUtils::getSatInUseFromNmeaGsa(data, size, &m_gsaRun))
+        m_inGsaRun = true;
+}
+
+void QNmeaSatelliteInfoSourcePrivate::finishGsvRun()
+{
+    bool complete = m_gsvRunComplete;
+    if (complete)
+        m_satellitesInView = m_gsvRun;
+
+    m_gsvRun.clear();
+    m_gsvGroup.clear();
+    m_lastGsvSentence = 0;
+    m_gsvRunComplete = false;
+    m_inGsvRun = false;
+
+    if (!complete)
+        return;
+
+    if (m_requestPending) {
+        m_requestPending = false;
+        if (m_requestTimer)
+            m_requestTimer->stop();
+        Q_EMIT m_source->satellitesInViewUpdated(m_satellitesInView);
+        Q_EMIT m_source->satellitesInUseUpdated(satellitesInUse());
+    } else if (m_invokedStart) {
+        Q_EMIT m_source->satellitesInViewUpdated(m_satellitesInView);
+    }
+}
+
+void QNmeaSatelliteInfoSourcePrivate::finishGsaRun()
+{
+    m_inUsePrnNumbers = m_gsaRun;
+    m_gsaRun.clear();
+    m_inGsaRun = false;
+
+    if (m_invokedStart)
+        Q_EMIT m_source->satellitesInUseUpdated(satellitesInUse());
+}
+
+// The satellites named by the last run of GSA sentences, with the details of the
+// last GSV groups where they are known.
+QList<QGeoSatelliteInfo> QNmeaSatelliteInfoSourcePrivate::satellitesInUse() const
+{
+    QList<QGeoSatelliteInfo> satellites;
+    for (int i = 0; i < m_inUsePrnNumbers.count(); ++i) {
+        int prn = m_inUsePrnNumbers.at(i);
+        QGeoSatelliteInfo satellite;
+        satellite.setPrnNumber(prn);
+        for (int j = 0; j < m_satellitesInView.count(); ++j) {
+            if (m_satellitesInView.at(j).prnNumber() == prn) {
+                satellite = m_satellitesInView.at(j);
+                break;
+            }
+        }
+        satellites.append(satellite);
+    }
+    return satellites;
+}
+
+//=========================================================
+
+/*!
+    \class QNmeaSatelliteInfoSource
+    \brief The QNmeaSatelliteInfoSource class provides satellite information using a NMEA data source.
+
+    \inmodule QtLocationSubset
+    \since 1.2
+
+    \ingroup location
+        \headerfile qnmeasatelliteinfosource.cpp <QtLocationSubset/QNmeaSatelliteInfoSource>
+    @xmlonly
+    <apigrouping group="Location/Positioning and Geocoding"/>
+    @endxmlonly
+
+    A QNmeaSatelliteInfoSource reads the GSV and GSA sentences of the NMEA
+    data read by a QNmeaPositionInfoSource. Both sources share the position
+    source's device and each sentence is read only once, so satellite and
+    position updates can be taken from the same GPS device or log file. In
+    \l {QNmeaPositionInfoSource::SimulationMode}{SimulationMode} the satellite
+    updates follow the playback of the position source.
+
+    The satellites in view are listed by a group of GSV sentences, and the
+    satellites used for the fix by a GSA sentence. Receivers that track more
+    than one constellation send a group and a GSA sentence for each of them
+    ("$GPGSV", "$GLGSV", "$GAGSV", ...). All groups and GSA sentences sent in
+    a row are combined, and satellitesInViewUpdated() and
+    satellitesInUseUpdated() are emitted once for them, when the next
+    sentence of another kind has been read. A group that misses a sentence
+    is dropped.
+
+    Use startUpdates() to start receiving regular updates and stopUpdates() to
+    stop them. This does not start or stop the position updates of the
+    position source.
+*/
+
+/*!
+    Constructs a QNmeaSatelliteInfoSource with the given \a parent that reads
+    the NMEA data of \a positionSource.
+*/
+QNmeaSatelliteInfoSource::QNmeaSatelliteInfoSource(QNmeaPositionInfoSource *positionSource, QObject *parent)
+        : QGeoSatelliteInfoSource(parent),
+        d(new QNmeaSatelliteInfoSourcePrivate(this, positionSource))
+{
+}
+
+/*!
+    Destroys the satellite source.
+*/
+QNmeaSatelliteInfoSource::~QNmeaSatelliteInfoSource()
+{
+    delete d;
+}
+
+/*!
+    Returns the position source that this source reads its NMEA data from,
+    or 0 if the position source has been destroyed.
+*/
+QNmeaPositionInfoSource *QNmeaSatelliteInfoSource::positionSource() const
+{
+    return d->m_positionSource;
+}
+
+/*!
+    \reimp
+*/
+void QNmeaSatelliteInfoSource::startUpdates()
+{
+    d->startUpdates();
+}
+
+/*!
+    \reimp
+*/
+void QNmeaSatelliteInfoSource::stopUpdates()
+{
+    d->stopUpdates();
+}
+
+/*!
+    \reimp
+
+    The satellites of the next run of GSV groups are emitted through
+    satellitesInViewUpdated(), followed by satellitesInUseUpdated() for the
+    last GSA sentences. If \a timeout is 0 the request does not time out.
+*/
+void QNmeaSatelliteInfoSource::requestUpdate(int timeout)
+{
+    d->requestUpdate(timeout);
+}
+
+#include "moc_qnmeasatelliteinfosource.cpp"
+#include "moc_qnmeasatelliteinfosource_p.cpp"
+
+QTMS_END_NAMESPACE
@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QNMEASATELLITEINFOSOURCE_P_H
+#define QNMEASATELLITEINFOSOURCE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qnmeasatelliteinfosource.h"
+#include "qnmeapositioninfosource.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+QT_BEGIN_HEADER
+
+QTMS_BEGIN_NAMESPACE
+
+class QNmeaSatelliteInfoSourcePrivate : public QObject
+{
+    Q_OBJECT
+public:
+    QNmeaSatelliteInfoSourcePrivate(QNmeaSatelliteInfoSource *parent, QNmeaPositionInfoSource *positionSource);
+    ~QNmeaSatelliteInfoSourcePrivate();
+
+    void startUpdates();
+    void stopUpdates();
+    void requestUpdate(int msec);
+    bool isActive() const;
+
+    // called by the position source for every sentence it reads
+    void processNmeaSentence(const char *data, int size);
+
+    QPointer<QNmeaPositionInfoSource> m_positionSource;
+
+private Q_SLOTS:
+    void updateRequestTimeout();
+
+private:
+    bool startReading();
+    void readGsv(const char *data, int size);
+    void readGsa(const char *data, int size);
+    void finishGsvRun();
+    void finishGsaRun();
+    QList<QGeoSatelliteInfo> satellitesInUse() const;
+
+    QNmeaSatelliteInfoSource *m_source;
+    QList<QGeoSatelliteInfo> m_satellitesInView;
+    QList<QGeoSatelliteInfo> m_gsvRun;      // complete GSV groups of the current run
+    QList<QGeoSatelliteInfo> m_gsvGroup;    // GSV group being assembled
+    char m_gsvTalker[2];
+    int m_lastGsvSentence;                  // 0 if no group is being assembled
+    bool m_gsvRunComplete;
+    bool m_inGsvRun;
+    QList<int> m_inUsePrnNumbers;
+    QList<int> m_gsaRun;
+    bool m_inGsaRun;
+    QTimer *m_requestTimer;
+    bool m_requestPending;
+    bool m_invokedStart;
+};
+
+QTMS_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif
@@ -0,0 +1,7 @@
+include(../../common.pri)
+
+TEMPLATE = subdirs
+SUBDIRS += qgeocoordinatedistance
+SUBDIRS += qgeocoordinatevalue
+SUBDIRS += qgeopositionhub
+SUBDIRS += qgeospatialindex
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+
+#include "qgeocoordinate.h"
+
+QTMS_USE_NAMESPACE
+
+Q_DECLARE_METATYPE(QGeoCoordinate::DistanceMode)
+
+static const int PointCount = 1000;
+
+// Times distanceTo() and atDistanceAndAzimuth() in each DistanceMode, over
+// PointCount hops of a few hundred meters and as many of a few thousand
+// kilometers.
+class tst_bench_QGeoCoordinateDistance : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void distanceTo_data();
+    void distanceTo();
+    void atDistanceAndAzimuth_data();
+    void atDistanceAndAzimuth();
+
+private:
+    void addRows();
+
+    QList<QGeoCoordinate> m_shortHops;
+    QList<QGeoCoordinate> m_longHops;
+};
+
+void tst_bench_QGeoCoordinateDistance::initTestCase()
+{
+    for (int i = 0; i < PointCount; ++i) {
+        m_shortHops.append(QGeoCoordinate(43.0 + (i % 7) * 0.001, -80.0 + (i % 11) * 0.002));
+        m_longHops.append(QGeoCoordinate(-60.0 + (i % 13) * 10.0, -170.0 + (i % 17) * 20.0));
+    }
+}
+
+void tst_bench_QGeoCoordinateDistance::addRows()
+{
+    QTest::addColumn<QGeoCoordinate::DistanceMode>("mode");
+    QTest::addColumn<bool>("longHops");
+
+    QTest::newRow("spherical, short") << QGeoCoordinate::SphericalDistance << false;
+    QTest::newRow("spherical, long") << QGeoCoordinate::SphericalDistance << true;
+    QTest::newRow("equirectangular, short") << QGeoCoordinate::EquirectangularDistance << false;
+    QTest::newRow("equirectangular, long") << QGeoCoordinate::EquirectangularDistance << true;
+    QTest::newRow("ellipsoidal, short") << QGeoCoordinate::EllipsoidalDistance << false;
+    QTest::newRow("ellipsoidal, long") << QGeoCoordinate::EllipsoidalDistance << true;
+}
+
+void tst_bench_QGeoCoordinateDistance::distanceTo_data()
+{
+    addRows();
+}
+
+void tst_bench_QGeoCoordinateDistance::distanceTo()
+{
+    QFETCH(QGeoCoordinate::DistanceMode, mode);
+    QFETCH(bool, longHops);
+
+    const QList<QGeoCoordinate> &points = longHops ? m_longHops : m_shortHops;
+    qreal total = 0.0;
+    QBENCHMARK {
+        for (int i = 1; i < points.count(); ++i)
+            total += points.at(i - 1).distanceTo(points.at(i), mode);
+    }
+    QVERIFY(total > 0.0);
+}
+
+void tst_bench_QGeoCoordinateDistance::atDistanceAndAzimuth_data()
+{
+    addRows();
+}
+
+void tst_bench_QGeoCoordinateDistance::atDistanceAndAzimuth()
+{
+    QFETCH(QGeoCoordinate::DistanceMode, mode);
+    QFETCH(bool, longHops);
+
+    const QList<QGeoCoordinate> &points = longHops ? m_longHops : m_shortHops;
+    qreal distance = longHops ? 3000000.0 : 300.0;
+    int valid = 0;
+    QBENCHMARK {
+        for (int i = 0; i < points.count(); ++i) {
+            if (points.at(i).atDistanceAndAzimuth(distance, (i * 37) % 360, 0.0, mode).isValid())
+                ++valid;
+        }
+    }
+    QVERIFY(valid > 0);
+}
+
+QTEST_MAIN(tst_bench_QGeoCoordinateDistance)
+
+#include "tst_bench_qgeocoordinatedistance.moc"
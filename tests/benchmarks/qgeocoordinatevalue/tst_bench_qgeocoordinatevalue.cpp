@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+
+#include "qgeocoordinate.h"
+#include "qgeocoordinatevalue.h"
+
+#include <new>
+#include <stdlib.h>
+
+QTMS_USE_NAMESPACE
+
+// Every allocation of the process is counted, the benchmarks reset the
+// count right before the code they measure.
+static int allocationCount = 0;
+
+void *operator new(size_t size) throw (std::bad_alloc)
+{
+    ++allocationCount;
+    void *memory = malloc(size ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void *operator new[](size_t size) throw (std::bad_alloc)
+{
+    return operator new(size);
+}
+
+void operator delete(void *memory) throw ()
+{
+    free(memory);
+}
+
+void operator delete[](void *memory) throw ()
+{
+    free(memory);
+}
+
+enum Workload {
+    Construct,
+    Distance,
+    Track
+};
+
+static const int PointCount = 1000;
+
+template <typename Coordinate>
+static qreal runWorkload(int workload, QVector<Coordinate> *points)
+{
+    qreal total = 0.0;
+
+    switch (workload) {
+    case Construct:
+        for (int i = 0; i < points->size(); ++i)
+            (*points)[i] = Coordinate(43.0 + i * 0.001, -80.0 + i * 0.002, 330.0);
+        break;
+    case Distance:
+        for (int i = 1; i < points->size(); ++i)
+            total += points->at(i - 1).distanceTo(points->at(i));
+        break;
+    case Track: {
+        Coordinate position = points->first();
+        for (int i = 0; i < points->size(); ++i) {
+            position = position.atDistanceAndAzimuth(25.0, i % 360);
+            total += position.latitude();
+        }
+        break;
+    }
+    }
+
+    return total;
+}
+
+template <typename Coordinate>
+static QVector<Coordinate> createPoints()
+{
+    QVector<Coordinate> points(PointCount);
+    runWorkload(Construct, &points);
+    return points;
+}
+
+template <typename Coordinate>
+static int countAllocations(int workload)
+{
+    QVector<Coordinate> points = createPoints<Coordinate>();
+
+    allocationCount = 0;
+    runWorkload(workload, &points);
+    return allocationCount;
+}
+
+// Compares the heap allocations and the time of the same work on
+// PointCount QGeoCoordinate objects, which allocate their private data,
+// and on as many QGeoCoordinateValue objects, which do not.
+class tst_bench_QGeoCoordinateValue : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void allocations_data();
+    void allocations();
+    void coordinate_data();
+    void coordinate();
+    void coordinateValue_data();
+    void coordinateValue();
+};
+
+void tst_bench_QGeoCoordinateValue::allocations_data()
+{
+    QTest::addColumn<int>("workload");
+    QTest::addColumn<bool>("value");
+
+    QTest::newRow("construct QGeoCoordinate") << int(Construct) << false;
+    QTest::newRow("construct QGeoCoordinateValue") << int(Construct) << true;
+    QTest::newRow("distance QGeoCoordinate") << int(Distance) << false;
+    QTest::newRow("distance QGeoCoordinateValue") << int(Distance) << true;
+    QTest::newRow("track QGeoCoordinate") << int(Track) << false;
+    QTest::newRow("track QGeoCoordinateValue") << int(Track) << true;
+}
+
+void tst_bench_QGeoCoordinateValue::allocations()
+{
+    QFETCH(int, workload);
+    QFETCH(bool, value);
+
+    int count = value ? countAllocations<QGeoCoordinateValue>(workload)
+                      : countAllocations<QGeoCoordinate>(workload);
+    QTest::setBenchmarkResult(count, QTest::Events);
+
+    if (value)
+        QCOMPARE(count, 0);
+}
+
+void tst_bench_QGeoCoordinateValue::coordinate_data()
+{
+    QTest::addColumn<int>("workload");
+
+    QTest::newRow("construct") << int(Construct);
+    QTest::newRow("distance") << int(Distance);
+    QTest::newRow("track") << int(Track);
+}
+
+void tst_bench_QGeoCoordinateValue::coordinate()
+{
+    QFETCH(int, workload);
+
+    QVector<QGeoCoordinate> points = createPoints<QGeoCoordinate>();
+    qreal total = 0.0;
+    QBENCHMARK {
+        total += runWorkload(workload, &points);
+    }
+    Q_UNUSED(total);
+}
+
+void tst_bench_QGeoCoordinateValue::coordinateValue_data()
+{
+    coordinate_data();
+}
+
+void tst_bench_QGeoCoordinateValue::coordinateValue()
+{
+    QFETCH(int, workload);
+
+    QVector<QGeoCoordinateValue> points = createPoints<QGeoCoordinateValue>();
+    qreal total = 0.0;
+    QBENCHMARK {
+        total += runWorkload(workload, &points);
+    }
+    Q_UNUSED(total);
+}
+
+QTEST_MAIN(tst_bench_QGeoCoordinateValue)
+
+#include "tst_bench_qgeocoordinatevalue.moc"
@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+
+#include "qgeopositionhub.h"
+#include "qgeopositioninfosource.h"
+
+QTMS_USE_NAMESPACE
+
+class BenchmarkSource : public QGeoPositionInfoSource
+{
+public:
+    BenchmarkSource() : QGeoPositionInfoSource(0) {}
+
+    void update(const QGeoPositionInfo &info) { Q_EMIT positionUpdated(info); }
+
+    QGeoPositionInfo lastKnownPosition(bool) const { return QGeoPositionInfo(); }
+    PositioningMethods supportedPositioningMethods() const { return AllPositioningMethods; }
+    int minimumUpdateInterval() const { return 0; }
+    void startUpdates() {}
+    void stopUpdates() {}
+    void requestUpdate(int) {}
+};
+
+class BenchmarkReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    BenchmarkReceiver() : received(0) {}
+
+    int received;
+
+public Q_SLOTS:
+    void positionUpdated(const QGeoPositionInfo &info)
+    {
+        if (info.isValid())
+            ++received;
+    }
+};
+
+// Compares delivering one update to many receivers through queued
+// positionUpdated() connections, which copy the QGeoPositionInfo once per
+// receiver, with publishing it once to a QGeoPositionHub that the same
+// number of readers poll.
+class tst_bench_QGeoPositionHub : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void signalFanOut_data();
+    void signalFanOut();
+    void hubFanOut_data();
+    void hubFanOut();
+
+private:
+    QGeoPositionInfo m_info;
+};
+
+void tst_bench_QGeoPositionHub::initTestCase()
+{
+    qRegisterMetaType<QGeoPositionInfo>();
+
+    m_info = QGeoPositionInfo(QGeoCoordinate(43.4723, -80.5449, 330.0),
+                              QDateTime::currentDateTime());
+    m_info.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 5.0);
+    m_info.setAttribute(QGeoPositionInfo::VerticalAccuracy, 8.0);
+    m_info.setAttribute(QGeoPositionInfo::GroundSpeed, 1.4);
+    m_info.setAttribute(QGeoPositionInfo::Direction, 270.0);
+}
+
+void tst_bench_QGeoPositionHub::signalFanOut_data()
+{
+    QTest::addColumn<int>("readers");
+
+    QTest::newRow("1 reader") << 1;
+    QTest::newRow("4 readers") << 4;
+    QTest::newRow("16 readers") << 16;
+    QTest::newRow("64 readers") << 64;
+}
+
+void tst_bench_QGeoPositionHub::signalFanOut()
+{
+    QFETCH(int, readers);
+
+    BenchmarkSource source;
+    QList<BenchmarkReceiver *> receivers;
+    for (int i = 0; i < readers; ++i) {
+        BenchmarkReceiver *receiver = new BenchmarkReceiver;
+        connect(&source, SIGNAL(positionUpdated(QGeoPositionInfo)),
+                receiver, SLOT(positionUpdated(QGeoPositionInfo)), Qt::QueuedConnection);
+        receivers.append(receiver);
+    }
+
+    QBENCHMARK {
+        source.update(m_info);
+        QCoreApplication::sendPostedEvents();
+    }
+
+    QVERIFY(receivers.first()->received > 0);
+    qDeleteAll(receivers);
+}
+
+void tst_bench_QGeoPositionHub::hubFanOut_data()
+{
+    signalFanOut_data();
+}
+
+void tst_bench_QGeoPositionHub::hubFanOut()
+{
+    QFETCH(int, readers);
+
+    BenchmarkSource source;
+    QGeoPositionHub hub;
+    hub.setSource(&source);
+
+    QList<QGeoPositionHubReader *> hubReaders;
+    for (int i = 0; i < readers; ++i)
+        hubReaders.append(new QGeoPositionHubReader(&hub));
+
+    int received = 0;
+    QGeoPositionFix fix;
+    QBENCHMARK {
+        source.update(m_info);
+        for (int i = 0; i < hubReaders.count(); ++i) {
+            while (hubReaders.at(i)->read(&fix))
+                ++received;
+        }
+    }
+
+    QVERIFY(received > 0);
+    QCOMPARE(hubReaders.first()->lostCount(), 0);
+    qDeleteAll(hubReaders);
+}
+
+QTEST_MAIN(tst_bench_QGeoPositionHub)
+
+#include "tst_bench_qgeopositionhub.moc"
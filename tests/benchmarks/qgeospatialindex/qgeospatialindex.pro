@@ -0,0 +1,11 @@
+include(../../../common.pri)
+
+TEMPLATE = app
+TARGET = tst_bench_qgeospatialindex
+CONFIG += qtestlib
+CONFIG -= app_bundle
+QT = core
+
+LIBS += -lQtLocationSubset$${BIN_SUFFIX}
+
+SOURCES += tst_bench_qgeospatialindex.cpp
@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the Qt Mobility Components.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** No Commercial Usage
+** This file contains pre-release code and may not be distributed.
+** You may use this file in accordance with the terms and conditions
+** contained in the Technology Preview License Agreement accompanying
+** this package.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at qt-info@nokia.com.
+**
+**
+**
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+
+#include "qgeoboundingbox.h"
+#include "qgeoboundingcircle.h"
+#include "qgeocoordinate.h"
+#include "qgeospatialindex.h"
+
+QTMS_USE_NAMESPACE
+
+// Compares the queries of a QGeoSpatialIndex with filtering the same
+// coordinates one by one with QGeoBoundingBox::contains() and
+// QGeoBoundingCircle::contains().
+class tst_bench_QGeoSpatialIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void build_data();
+    void build();
+    void box_data();
+    void box();
+    void circle_data();
+    void circle();
+
+private:
+    static QList<QGeoCoordinate> createCoordinates(int count);
+};
+
+// Spreads the coordinates pseudo-randomly over a region of about
+// 200 km by 200 km, like the points of interest of a city and its area.
+QList<QGeoCoordinate> tst_bench_QGeoSpatialIndex::createCoordinates(int count)
+{
+    QList<QGeoCoordinate> coordinates;
+    uint seed = 12345;
+    for (int i = 0; i < count; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        double latitude = 42.5 + double(seed % 100000) / 50000.0;
+        seed = seed * 1103515245u + 12345u;
+        double longitude = -81.5 + double(seed % 100000) / 40000.0;
+        coordinates.append(QGeoCoordinate(latitude, longitude));
+    }
+    return coordinates;
+}
+
+void tst_bench_QGeoSpatialIndex::build_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void tst_bench_QGeoSpatialIndex::build()
+{
+    QFETCH(int, count);
+
+    QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QBENCHMARK {
+        QGeoSpatialIndex index(coordinates);
+        QCOMPARE(index.count(), count);
+    }
+}
+
+void tst_bench_QGeoSpatialIndex::box_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("linear");
+
+    QTest::newRow("index, 1000") << 1000 << false;
+    QTest::newRow("linear, 1000") << 1000 << true;
+    QTest::newRow("index, 10000") << 10000 << false;
+    QTest::newRow("linear, 10000") << 10000 << true;
+    QTest::newRow("index, 100000") << 100000 << false;
+    QTest::newRow("linear, 100000") << 100000 << true;
+}
+
+void tst_bench_QGeoSpatialIndex::box()
+{
+    QFETCH(int, count);
+    QFETCH(bool, linear);
+
+    QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QGeoSpatialIndex index(coordinates);
+    QGeoBoundingBox box(QGeoCoordinate(43.5, -80.5), 0.1, 0.1);
+
+    QList<int> found;
+    if (linear) {
+        QBENCHMARK {
+            found.clear();
+            for (int i = 0; i < coordinates.count(); ++i) {
+                if (box.contains(coordinates.at(i)))
+                    found.append(i);
+            }
+        }
+    } else {
+        QBENCHMARK {
+            found = index.indexesWithin(box);
+        }
+    }
+
+    QCOMPARE(found.count(), index.indexesWithin(box).count());
+}
+
+void tst_bench_QGeoSpatialIndex::circle_data()
+{
+    box_data();
+}
+
+void tst_bench_QGeoSpatialIndex::circle()
+{
+    QFETCH(int, count);
+    QFETCH(bool, linear);
+
+    QList<QGeoCoordinate> coordinates = createCoordinates(count);
+    QGeoSpatialIndex index(coordinates);
+    QGeoBoundingCircle circle(QGeoCoordinate(43.5, -80.5), 5000.0);
+
+    QList<int> found;
+    if (linear) {
+        QBENCHMARK {
+            found.clear();
+            for (int i = 0; i < coordinates.count(); ++i) {
+                if (circle.contains(coordinates.at(i)))
+                    found.append(i);
+            }
+        }
+    } else {
+        QBENCHMARK {
+            found = index.indexesWithin(circle);
+        }
+    }
+
+    QCOMPARE(found.count(), index.indexesWithin(circle).count());
+}
+
+QTEST_MAIN(tst_bench_QGeoSpatialIndex)
+
+#include "tst_bench_qgeospatialindex.moc"
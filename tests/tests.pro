@@ -0,0 +1,4 @@
+include(../common.pri)
+
+TEMPLATE = subdirs
+SUBDIRS += benchmarks